@@ -1,4 +1,5 @@
 #include "bench_merklize.hpp"
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
@@ -7,16 +8,41 @@
 std::string
 to_readable_timespan(double ts);
 
-// Compute average execution time of kernel
+// Compute average execution time of kernel, also writing level from where
+// `merklize_hybrid` computes nodes on host, to `cutover_lvl`
+//
+// When benchmarking `merklize_numa`, it runs on `numa_qs` ( see `numa_queues`
+// ), from whose context host buffers are allocated too
 //
 // taken from
 // https://github.com/itzmeanjan/blake3/blob/8b07337774df0544d411d04caf6ccd23c571b4f4/bench/main.cpp#L111-L156
+template<typename H>
 void
 take_avg(sycl::queue& q,
          size_t leaf_cnt,
          size_t wg_size,
+         merklize_engine engine,
+         size_t engine_arg,
          size_t itr_cnt,
-         double* const ts);
+         double* const ts,
+         size_t* const cutover_lvl,
+         const size_t* const lvl_wg_sizes = nullptr,
+         std::vector<sycl::queue>* const numa_qs = nullptr);
+
+// Runs benchmark for all chosen leaf counts, printing results in tabular form
+//
+// When benchmarking `merklize_arbitrary`, leaf counts which are not power of 2
+// are also chosen
+template<typename H>
+void
+bench_table(sycl::queue& q,
+            size_t wg_size,
+            merklize_engine engine,
+            size_t engine_arg,
+            size_t itr_cnt,
+            double* const ts,
+            const size_t* const lvl_wg_sizes = nullptr,
+            std::vector<sycl::queue>* const numa_qs = nullptr);
 
 // This function implementation is adapted from
 // https://github.com/itzmeanjan/blake3/blob/8b07337774df0544d411d04caf6ccd23c571b4f4/bench/main.cpp#L24-L26
@@ -35,87 +61,312 @@ main(int argc, char** argv)
 
   const size_t wg_size = 1 << 5;
   const size_t itr_cnt = 1 << 3;
+  // at max these many levels can be fused by a work-group of above size
+  const size_t fused_lvl_cnt =
+    static_cast<size_t>(sycl::log2(static_cast<double>(wg_size))) + 1;
+  // tree levels having at max these many nodes are computed on host
+  const size_t host_node_cnt = 1 << 12;
+  // leaf count of each tree, when benchmarking batched merklization
+  const size_t batch_leaf_cnt = 1 << 10;
+  // leaf count of each chunk, when benchmarking out-of-core merklization
+  const size_t chunk_leaf_cnt = 1 << 20;
+  // # -of segments leaf nodes are uploaded in, when benchmarking pipelined
+  // merklization
+  const size_t seg_cnt = 1 << 4;
+  // leaf count of tree, on which work-group sizes are tuned
+  const size_t tune_leaf_cnt = 1 << 20;
 
-  double* ts = (double*)std::malloc(sizeof(double) * 3);
+  double* ts = (double*)std::malloc(sizeof(double) * 4);
 
-#if defined SHA1
-  std::cout << "\nBenchmarking Binary Merklization using SHA1" << std::endl
-            << std::endl;
-#elif defined SHA2_224
-  std::cout << "\nBenchmarking Binary Merklization using SHA2-224" << std::endl
-            << std::endl;
-#elif defined SHA2_256
-  std::cout << "\nBenchmarking Binary Merklization using SHA2-256" << std::endl
-            << std::endl;
-#elif defined SHA2_384
-  std::cout << "\nBenchmarking Binary Merklization using SHA2-384" << std::endl
-            << std::endl;
-#elif defined SHA2_512
-  std::cout << "\nBenchmarking Binary Merklization using SHA2-512" << std::endl
-            << std::endl;
-#elif defined SHA2_512_224
-  std::cout << "\nBenchmarking Binary Merklization using SHA2-512/224"
-            << std::endl
-            << std::endl;
-#elif defined SHA2_512_256
-  std::cout << "\nBenchmarking Binary Merklization using SHA2-512/256"
+  // SHA variant to be used as 2-to-1 hash function is chosen at run-time,
+  // using first command line argument, SHA2-256 being default choice !
+  hasher::variant v = hasher::variant::sha2_256;
+  if (argc > 1 && !hasher::from_id(argv[1], &v)) {
+    std::cerr << "unknown SHA variant " << argv[1] << ", choose one of";
+    for (hasher::variant v_ : hasher::VARIANTS) {
+      std::cerr << " " << hasher::id(v_);
+    }
+    std::cerr << std::endl;
+
+    std::free(ts);
+    return EXIT_FAILURE;
+  }
+
+  // device is partitioned by NUMA affinity domain only once, while queues are
+  // reused by all iterations of `merklize_numa` benchmark
+  std::vector<sycl::queue> numa_qs = numa_queues(d);
+
+  // work-group sizes tuned on this device are kept in cache file, which are
+  // ( re-)tuned when second command line argument is `tune`
+  autotuner tuner{ q, "merklize_tuning.cache" };
+  if (argc > 2 && std::strcmp(argv[2], "tune") == 0) {
+    std::cout << "tuning work-group sizes of " << hasher::name(v) << " ..."
+              << std::endl;
+
+    if (!tuner.tune(v, tune_leaf_cnt, itr_cnt, true)) {
+      std::cerr << "failed to write tuning cache file" << std::endl;
+    }
+  }
+
+  std::cout << "\nBenchmarking Binary Merklization using " << hasher::name(v)
             << std::endl
             << std::endl;
-#elif defined SHA3_256
-  std::cout << "\nBenchmarking Binary Merklization using SHA3-256" << std::endl
-            << std::endl;
-#elif defined SHA3_224
-  std::cout << "\nBenchmarking Binary Merklization using SHA3-224" << std::endl
-            << std::endl;
-#elif defined SHA3_384
-  std::cout << "\nBenchmarking Binary Merklization using SHA3-384" << std::endl
-            << std::endl;
-#elif defined SHA3_512
-  std::cout << "\nBenchmarking Binary Merklization using SHA3-512" << std::endl
-            << std::endl;
-#elif defined KECCAK_256_U64
-  std::cout
-    << "\nBenchmarking Binary Merklization using KECCAK-256 ( 64 -bit word )"
-    << std::endl
-    << std::endl;
-#elif defined KECCAK_256_U32
-  std::cout
-    << "\nBenchmarking Binary Merklization using KECCAK-256 ( 32 -bit word )"
-    << std::endl
-    << std::endl;
-#endif
 
+  // all benchmarks are run using fully specialized kernels of chosen variant
+  hasher::dispatch(v, [&](auto h) {
+    using H = decltype(h);
+
+    std::cout << "\nOne tree level per kernel dispatch" << std::endl
+              << std::endl;
+    bench_table<H>(q, wg_size, merklize_engine::per_level, 1, itr_cnt, ts);
+
+    // same as above, but SHA2 compression keeps message schedule in 16 -word
+    // circular window, with all rounds unrolled
+    if constexpr (hasher::has_rolling_core<H>) {
+      using R = hasher::sha2_rolling<H>;
+
+      std::cout << "\nOne tree level per kernel dispatch, rolling message "
+                   "schedule SHA2 compression"
+                << std::endl
+                << std::endl;
+      bench_table<R>(q, wg_size, merklize_engine::per_level, 1, itr_cnt, ts);
+    }
+
+    // same as above, but keccak-p[1600, 24] permutation is specialized for
+    // tree hashing
+    if constexpr (hasher::has_tree_permutation<H>) {
+      using T = hasher::keccak_tree<H>;
+
+      std::cout << "\nOne tree level per kernel dispatch, keccak-p[1600, 24] "
+                   "specialized for tree hashing"
+                << std::endl
+                << std::endl;
+      bench_table<T>(q, wg_size, merklize_engine::per_level, 1, itr_cnt, ts);
+    }
+
+    // same as above, but Keccak-256 intermediate nodes are kept in bit
+    // interleaved form, on all tree levels
+    if constexpr (std::is_same_v<H, hasher::keccak_256_u32> ||
+                  std::is_same_v<H, hasher::keccak_256_u64>) {
+      using I = hasher::keccak_256_interleaved;
+
+      std::cout << "\nOne tree level per kernel dispatch, bit interleaved "
+                   "intermediate nodes"
+                << std::endl
+                << std::endl;
+      bench_table<I>(q, wg_size, merklize_engine::per_level, 1, itr_cnt, ts);
+    }
+
+    std::cout << "\nFusing " << fused_lvl_cnt
+              << " tree levels per kernel dispatch" << std::endl
+              << std::endl;
+    bench_table<H>(
+      q, wg_size, merklize_engine::fused, fused_lvl_cnt, itr_cnt, ts);
+
+    std::cout << "\nAll tree levels in single kernel dispatch" << std::endl
+              << std::endl;
+    bench_table<H>(q, wg_size, merklize_engine::persistent, 1, itr_cnt, ts);
+
+    std::cout << "\nTree levels having <= " << host_node_cnt
+              << " nodes computed on host" << std::endl
+              << std::endl;
+    bench_table<H>(
+      q, wg_size, merklize_engine::hybrid, host_node_cnt, itr_cnt, ts);
+
+    std::cout << "\nArbitrary leaf count, odd nodes promoted" << std::endl
+              << std::endl;
+    bench_table<H>(q,
+                   wg_size,
+                   merklize_engine::arbitrary,
+                   static_cast<size_t>(odd_node_policy::promote),
+                   itr_cnt,
+                   ts);
+
+    std::cout << "\nArbitrary leaf count, odd nodes duplicated" << std::endl
+              << std::endl;
+    bench_table<H>(q,
+                   wg_size,
+                   merklize_engine::arbitrary,
+                   static_cast<size_t>(odd_node_policy::duplicate),
+                   itr_cnt,
+                   ts);
+
+    std::cout << "\nBatches of trees, each having " << batch_leaf_cnt
+              << " leaf nodes" << std::endl
+              << std::endl;
+    bench_table<H>(
+      q, wg_size, merklize_engine::batched, batch_leaf_cnt, itr_cnt, ts);
+
+    std::cout << "\nOut-of-core, chunks of " << chunk_leaf_cnt
+              << " leaf nodes, double buffered" << std::endl
+              << std::endl;
+    bench_table<H>(
+      q, wg_size, merklize_engine::streamed, chunk_leaf_cnt, itr_cnt, ts);
+
+    std::cout << "\nLeaf nodes uploaded in " << seg_cnt
+              << " segments, overlapping first phase" << std::endl
+              << std::endl;
+    bench_table<H>(
+      q, wg_size, merklize_engine::pipelined, seg_cnt, itr_cnt, ts);
+
+    std::cout << "\nTree levels copied back to host, as soon as computed"
+              << std::endl
+              << std::endl;
+    bench_table<H>(q, wg_size, merklize_engine::readback, 0, itr_cnt, ts);
+
+    std::cout << "\nSubtrees merklized across " << numa_qs.size()
+              << " NUMA domain(s), roots merged on host" << std::endl
+              << std::endl;
+    bench_table<H>(
+      q, wg_size, merklize_engine::numa, 0, itr_cnt, ts, nullptr, &numa_qs);
+
+    // leaf nodes living on each kind of memory, read in place when possible
+    constexpr std::pair<leaf_input, const char*> srcs[] = {
+      { leaf_input::device, "device" },
+      { leaf_input::shared, "shared" },
+      { leaf_input::host, "host" },
+      { leaf_input::pageable, "pageable ( zero-copy )" },
+    };
+
+    for (const auto& [src, src_name] : srcs) {
+      std::cout << "\nLeaf nodes living on " << src_name << " memory, "
+                << (reads_in_place(q, src) ? "read in place" : "staged")
+                << std::endl
+                << std::endl;
+      bench_table<H>(q,
+                     wg_size,
+                     merklize_engine::zero_copy,
+                     static_cast<size_t>(src),
+                     itr_cnt,
+                     ts);
+    }
+  });
+
+  // merklization using tuned settings, which may choose another implementation
+  // variant of same hash function
+  if (tuner.tuned(v)) {
+    const tuned_config cfg = tuner.config(v);
+    const tuned_config pref = tuner.config(cfg.preferred);
+
+    size_t lvl_wg_sizes[TUNED_LVL_CNT];
+    resolve_wg_sizes(pref.wg_sizes, lvl_wg_sizes);
+
+    std::cout << "\nAutotuned, using " << hasher::name(cfg.preferred)
+              << ", work-group size per level width" << std::endl;
+    for (size_t k = 0; k < TUNED_LVL_CNT; k++) {
+      if (pref.wg_sizes[k] != 0) {
+        std::cout << "\t2 ^ " << k << " : " << pref.wg_sizes[k] << std::endl;
+      }
+    }
+    std::cout << std::endl;
+
+    hasher::dispatch(cfg.preferred, [&](auto h) {
+      using H = decltype(h);
+
+      bench_table<H>(q,
+                     wg_size,
+                     merklize_engine::autotuned,
+                     0,
+                     itr_cnt,
+                     ts,
+                     lvl_wg_sizes);
+    });
+  }
+
+  std::free(ts);
+
+  return EXIT_SUCCESS;
+}
+
+template<typename H>
+void
+bench_table(sycl::queue& q,
+            size_t wg_size,
+            merklize_engine engine,
+            size_t engine_arg,
+            size_t itr_cnt,
+            double* const ts,
+            const size_t* const lvl_wg_sizes,
+            std::vector<sycl::queue>* const numa_qs)
+{
   std::cout << std::setw(16) << std::right << "leaf count"
             << "\t\t" << std::setw(16) << std::right << "execution time"
             << "\t\t" << std::setw(16) << std::right << "host-to-device tx time"
-            << "\t\t" << std::setw(16) << std::right << "device-to-host tx time"
-            << std::endl;
+            << "\t\t" << std::setw(16) << std::right
+            << "device-to-host tx time";
+  if (engine == merklize_engine::hybrid) {
+    std::cout << "\t\t" << std::setw(16) << std::right << "host cutover level";
+  }
+  if (engine == merklize_engine::pipelined ||
+      engine == merklize_engine::readback) {
+    std::cout << "\t\t" << std::setw(16) << std::right << "hidden tx time";
+  }
+  std::cout << std::endl;
 
+  std::vector<size_t> leaf_cnts;
   for (size_t i = 20; i <= 25; i++) {
-    const size_t leaf_cnt = 1 << i;
+    leaf_cnts.push_back(1ul << i);
+
+    if (engine == merklize_engine::arbitrary && i < 25) {
+      leaf_cnts.push_back((1ul << i) + 1);
+      leaf_cnts.push_back((1ul << i) + (1ul << (i - 1)));
+      leaf_cnts.push_back((1ul << (i + 1)) - 1);
+    }
+  }
+
+  for (size_t leaf_cnt : leaf_cnts) {
+    size_t cutover_lvl = 0;
 
-    take_avg(q, leaf_cnt, wg_size, itr_cnt, ts);
+    take_avg<H>(q,
+                leaf_cnt,
+                wg_size,
+                engine,
+                engine_arg,
+                itr_cnt,
+                ts,
+                &cutover_lvl,
+                lvl_wg_sizes,
+                numa_qs);
 
-    std::cout << std::setw(12) << std::right << "2 ^ " << i << "\t\t"
-              << std::setw(22) << std::right << to_readable_timespan(*(ts + 1))
+    if ((leaf_cnt & (leaf_cnt - 1)) == 0) {
+      const size_t i =
+        static_cast<size_t>(sycl::log2(static_cast<double>(leaf_cnt)));
+      std::cout << std::setw(12) << std::right << "2 ^ " << i;
+    } else {
+      std::cout << std::setw(14) << std::right << leaf_cnt;
+    }
+
+    std::cout << "\t\t" << std::setw(22) << std::right
+              << to_readable_timespan(*(ts + 1))
               << "\t\t" << std::setw(22) << std::right
               << to_readable_timespan(*(ts + 0)) << "\t\t" << std::setw(22)
-              << std::right << to_readable_timespan(*(ts + 2)) << std::endl;
+              << std::right << to_readable_timespan(*(ts + 2));
+    if (engine == merklize_engine::hybrid) {
+      std::cout << "\t\t" << std::setw(18) << std::right << cutover_lvl;
+    }
+    if (engine == merklize_engine::pipelined ||
+        engine == merklize_engine::readback) {
+      std::cout << "\t\t" << std::setw(16) << std::right
+                << to_readable_timespan(*(ts + 3));
+    }
+    std::cout << std::endl;
   }
-
-  std::free(ts);
-
-  return EXIT_SUCCESS;
 }
 
+template<typename H>
 void
 take_avg(sycl::queue& q,
          size_t leaf_cnt,
          size_t wg_size,
+         merklize_engine engine,
+         size_t engine_arg,
          size_t itr_cnt,
-         double* const ts)
+         double* const ts,
+         size_t* const cutover_lvl,
+         const size_t* const lvl_wg_sizes,
+         std::vector<sycl::queue>* const numa_qs)
 {
-  size_t req_size = sizeof(sycl::cl_ulong) * 3;
+  size_t req_size = sizeof(sycl::cl_ulong) * 4;
 
   sycl::cl_ulong* ts_acc = (sycl::cl_ulong*)std::malloc(req_size);
   sycl::cl_ulong* ts_cur = (sycl::cl_ulong*)std::malloc(req_size);
@@ -123,17 +374,33 @@ take_avg(sycl::queue& q,
   // so that accumulation begins with empty slate !
   memset(ts_acc, 0, req_size);
 
+  // buffers are allocated ( and pre-faulted ) during first iteration, while
+  // later iterations recycle them
+  //
+  // `merklize_numa` requires them to be allocated from context of NUMA domain
+  // queues
+  usm_pool pool{ engine == merklize_engine::numa ? numa_qs->front() : q, true };
+
   for (size_t i = 0; i < itr_cnt; i++) {
-    benchmark_merklize(q, leaf_cnt, wg_size, ts_cur);
+    benchmark_merklize<H>(q,
+                          pool,
+                          leaf_cnt,
+                          wg_size,
+                          engine,
+                          engine_arg,
+                          ts_cur,
+                          cutover_lvl,
+                          lvl_wg_sizes,
+                          numa_qs);
 
-#pragma unroll 3
-    for (size_t j = 0; j < 3; j++) {
-      *(ts_acc + i) += *(ts_cur + i);
+#pragma unroll 4
+    for (size_t j = 0; j < 4; j++) {
+      *(ts_acc + j) += *(ts_cur + j);
     }
   }
 
-#pragma unroll 3
-  for (size_t i = 0; i < 3; i++) {
+#pragma unroll 4
+  for (size_t i = 0; i < 4; i++) {
     *(ts + i) = (double)*(ts_acc + i) / (double)itr_cnt;
   }
 
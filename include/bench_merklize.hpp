@@ -1,85 +1,228 @@
 #pragma once
-#include "merklize.hpp"
+#include "merklize_arbitrary.hpp"
+#include "merklize_autotune.hpp"
+#include "merklize_batch.hpp"
+#include "merklize_fused.hpp"
+#include "merklize_hybrid.hpp"
+#include "merklize_interleaved.hpp"
+#include "merklize_numa.hpp"
+#include "merklize_persistent.hpp"
+#include "merklize_pipelined.hpp"
+#include "merklize_readback.hpp"
+#include "merklize_stream.hpp"
+#include "merklize_zero_copy.hpp"
+#include "usm_pool.hpp"
 #include <cassert>
 #include <random>
 
 // Benchmarks binary merklization implementation --- collects motivation from
 // https://github.com/itzmeanjan/blake3/blob/e2a1340/include/bench_merklize.hpp#L6-L10
 //
-// Which SHA variant of 2-to-1 hash function to be used in a compile-time
-// decision using preprocessor directives
+// Which SHA variant of 2-to-1 hash function to be used is chosen using hasher
+// policy `H` ( see hasher.hpp )
 //
-// If none chosen, SHA2-256 is chosen by default !
+// Which binary merklization implementation to be benchmarked, is chosen using
+// `engine`, where `engine_arg` is used as `fused_lvl_cnt` with
+// `merklize_fused`, as `host_node_cnt` with `merklize_hybrid`, as
+// `odd_node_policy` with `merklize_arbitrary` and as leaf count of each tree
+// with `merklize_batch`, where `leaf_cnt` is total leaf count of all trees in
+// batch, as chunk leaf count with `merklize_stream` and as # -of upload
+// segments with `merklize_pipelined`, as `leaf_input` with
+// `merklize_zero_copy`, while it's ignored by `merklize_readback`,
+// `merklize_numa` ( which runs on `numa_qs`, see `numa_queues` ) &
+// `merklize_tuned`, which takes work-group size of each level from
+// `lvl_wg_sizes` ( see `resolve_wg_sizes` )
+//
+// Only `merklize_arbitrary` can be used when leaf count is not power of 2
+//
+// Level from where `merklize_hybrid` computes nodes on host, is written to
+// `cutover_lvl`, while it's set to 0 for other engines
+//
+// Data transfer time, which was hidden behind merklization, is written to
+// `ts[3]`, which is non-zero only for `merklize_pipelined` ( host to device )
+// and `merklize_readback` ( device to host )
+//
+// Host & device buffers are taken from `pool`, which is shared by all
+// iterations, so that USM allocation & first-touch page faults are not paid
+// for on each of them; for `merklize_numa`, `pool` must allocate from context
+// of `numa_qs`, which are also created once, by caller
+enum class merklize_engine
+{
+  per_level,  // `merklize`, one tree level per kernel dispatch
+  fused,      // `merklize_fused`, multiple tree levels per kernel dispatch
+  persistent, // `merklize_persistent`, single kernel dispatch
+  hybrid,     // `merklize_hybrid`, upper tree levels computed on host
+  arbitrary,  // `merklize_arbitrary`, leaf count need not be power of 2
+  batched,    // `merklize_batch`, many equal sized trees at once
+  streamed,   // `merklize_stream`, out-of-core, chunk by chunk
+  pipelined,  // `merklize_pipelined`, segmented upload overlapping hashing
+  readback,   // `merklize_readback`, levels copied back while hashing
+  zero_copy,  // `merklize_zero_copy`, leaf nodes read in place
+  autotuned,  // `merklize_tuned`, tuned work-group size per level
+  numa,       // `merklize_numa`, one subtree per NUMA domain
+};
+
+template<typename H>
 void
 benchmark_merklize(sycl::queue& q,
+                   usm_pool& pool,
                    size_t leaf_cnt,
                    size_t wg_size,
-                   sycl::cl_ulong* const ts)
+                   merklize_engine engine,
+                   size_t engine_arg,
+                   sycl::cl_ulong* const ts,
+                   size_t* const cutover_lvl,
+                   const size_t* const lvl_wg_sizes = nullptr,
+                   std::vector<sycl::queue>* const numa_qs = nullptr)
 {
+  using word_t = typename H::word_t;
+
   // this implementation is only helpful when
   // relatively large number of leaf nodes are
   // required to be merklized
   assert(leaf_cnt >= (1 << 20));
 
-#if defined SHA1
-  const size_t i_size = leaf_cnt * sha1::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha1::OUT_LEN_BYTES; // in bytes
-#elif defined SHA2_224
-  const size_t i_size = leaf_cnt * sha2_224::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha2_224::OUT_LEN_BYTES; // in bytes
-#elif defined SHA2_256
-  const size_t i_size = leaf_cnt * sha2_256::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha2_256::OUT_LEN_BYTES; // in bytes
-#elif defined SHA2_384
-  const size_t i_size = leaf_cnt * sha2_384::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha2_384::OUT_LEN_BYTES; // in bytes
-#elif defined SHA2_512
-  const size_t i_size = leaf_cnt * sha2_512::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha2_512::OUT_LEN_BYTES; // in bytes
-#elif defined SHA2_512_224
-  const size_t i_size = leaf_cnt * sha2_512_224::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * 32;                          // in bytes
-#elif defined SHA2_512_256
-  const size_t i_size = leaf_cnt * sha2_512_256::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha2_512_256::OUT_LEN_BYTES; // in bytes
-#elif defined SHA3_256
-  const size_t i_size = leaf_cnt * sha3_256::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha3_256::OUT_LEN_BYTES; // in bytes
-#elif defined SHA3_224
-  const size_t i_size = leaf_cnt * sha3_224::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha3_224::OUT_LEN_BYTES; // in bytes
-#elif defined SHA3_384
-  const size_t i_size = leaf_cnt * sha3_384::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha3_384::OUT_LEN_BYTES; // in bytes
-#elif defined SHA3_512
-  const size_t i_size = leaf_cnt * sha3_512::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * sha3_512::OUT_LEN_BYTES; // in bytes
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-  const size_t i_size = leaf_cnt * keccak_256::OUT_LEN_BYTES; // in bytes
-  const size_t o_size = leaf_cnt * keccak_256::OUT_LEN_BYTES; // in bytes
-#endif
-
-#if defined SHA1 || defined SHA2_224 || defined SHA2_256
-  // allocate resources
-  sycl::uint* i_h = static_cast<sycl::uint*>(sycl::malloc_host(i_size, q));
-  sycl::uint* o_h = static_cast<sycl::uint*>(sycl::malloc_host(o_size, q));
-  sycl::uint* i_d = static_cast<sycl::uint*>(sycl::malloc_device(i_size, q));
-  sycl::uint* o_d = static_cast<sycl::uint*>(sycl::malloc_device(o_size, q));
-#elif defined SHA2_384 || defined SHA2_512 || defined SHA2_512_224 ||          \
-  defined SHA2_512_256
-  // allocate resources
-  sycl::ulong* i_h = static_cast<sycl::ulong*>(sycl::malloc_host(i_size, q));
-  sycl::ulong* o_h = static_cast<sycl::ulong*>(sycl::malloc_host(o_size, q));
-  sycl::ulong* i_d = static_cast<sycl::ulong*>(sycl::malloc_device(i_size, q));
-  sycl::ulong* o_d = static_cast<sycl::ulong*>(sycl::malloc_device(o_size, q));
-#elif defined SHA3_256 || defined SHA3_224 || defined SHA3_384 ||              \
-  defined SHA3_512 || defined KECCAK_256_U64 || defined KECCAK_256_U32
-  // allocate resources
-  sycl::uchar* i_h = static_cast<sycl::uchar*>(sycl::malloc_host(i_size, q));
-  sycl::uchar* o_h = static_cast<sycl::uchar*>(sycl::malloc_host(o_size, q));
-  sycl::uchar* i_d = static_cast<sycl::uchar*>(sycl::malloc_device(i_size, q));
-  sycl::uchar* o_d = static_cast<sycl::uchar*>(sycl::malloc_device(o_size, q));
-#endif
+  // leaf nodes are provided as ceil(leaf_cnt / 2) -many pairs, while output
+  // memory allocation holds all intermediate nodes, following layout computed
+  // by `level_offsets`, which is same as `merklize` produces, when leaf count
+  // is power of 2
+  const size_t i_size = ((leaf_cnt + 1) >> 1) * H::LEAF_PAIR_WORDS *
+                        sizeof(word_t); // in bytes
+  const size_t o_size =
+    (intermediate_cnt(leaf_cnt) + 1) * H::NODE_LEN_BYTES; // in bytes
+
+  *cutover_lvl = 0;
+
+  // out-of-core merklization never keeps whole tree in accelerator memory,
+  // while it interleaves data transfers with kernel dispatches
+  if (engine == merklize_engine::streamed) {
+    word_t* i_h = pool.allocate<word_t>(i_size, sycl::usm::alloc::host);
+
+    {
+      std::random_device rd;
+      std::mt19937 gen(rd());
+      std::uniform_int_distribution<uint8_t> dis(0, 255);
+
+      memset(i_h, dis(gen), i_size); // prepare (random) input bytes
+    }
+
+    word_t root[H::NODE_WORDS];
+    sycl::cl_ulong tx_ts[2];
+
+    *(ts + 1) = merklize_stream<H>(
+      q, i_h, i_size, leaf_cnt, root, engine_arg, wg_size, tx_ts);
+    *(ts + 0) = tx_ts[0];
+    *(ts + 2) = tx_ts[1];
+    *(ts + 3) = 0;
+
+    pool.release(i_h);
+    return;
+  }
+
+  // each NUMA domain stages its own slice of leaf nodes, living on host, while
+  // intermediate nodes are copied back to host, subtree by subtree
+  if (engine == merklize_engine::numa) {
+    assert(numa_qs != nullptr && !numa_qs->empty());
+
+    word_t* i_h = pool.allocate<word_t>(i_size, sycl::usm::alloc::host);
+    word_t* o_h = pool.allocate<word_t>(o_size, sycl::usm::alloc::host);
+
+    {
+      std::random_device rd;
+      std::mt19937 gen(rd());
+      std::uniform_int_distribution<uint8_t> dis(0, 255);
+
+      memset(i_h, dis(gen), i_size); // prepare (random) input bytes
+    }
+
+    sycl::cl_ulong tx_ts[2];
+
+    *(ts + 1) = merklize_numa<H>(
+      *numa_qs, i_h, i_size, leaf_cnt, o_h, o_size, wg_size, tx_ts);
+    *(ts + 0) = tx_ts[0];
+    *(ts + 2) = tx_ts[1];
+    *(ts + 3) = 0;
+
+    pool.release(i_h);
+    pool.release(o_h);
+    return;
+  }
+
+  // leaf nodes are placed on chosen kind of memory, from where they're read
+  // in place, whenever device allows it; when they're placed on accelerator
+  // memory, they're copied there from pinned host memory, as usual
+  if (engine == merklize_engine::zero_copy) {
+    const leaf_input src = static_cast<leaf_input>(engine_arg);
+
+    word_t* i_h = pool.allocate<word_t>(i_size, sycl::usm::alloc::host);
+    word_t* o_h = pool.allocate<word_t>(o_size, sycl::usm::alloc::host);
+    word_t* o_d = pool.allocate<word_t>(o_size, sycl::usm::alloc::device);
+
+    word_t* i = nullptr;
+    switch (src) {
+      case leaf_input::device:
+        i = pool.allocate<word_t>(i_size, sycl::usm::alloc::device);
+        break;
+      case leaf_input::shared:
+        i = pool.allocate<word_t>(i_size, sycl::usm::alloc::shared);
+        break;
+      case leaf_input::host:
+        i = i_h;
+        break;
+      default:
+        i = static_cast<word_t*>(std::malloc(i_size));
+        break;
+    }
+
+    {
+      std::random_device rd;
+      std::mt19937 gen(rd());
+      std::uniform_int_distribution<uint8_t> dis(0, 255);
+
+      memset(i_h, dis(gen), i_size); // prepare (random) input bytes
+    }
+
+    q.memset(o_d, 0, o_size).wait();
+
+    sycl::cl_ulong ts_0 = 0;
+
+    if (src == leaf_input::device) {
+      sycl::event evt_0 = q.memcpy(i, i_h, i_size);
+      evt_0.wait();
+      ts_0 = time_event(evt_0);
+    } else if (src != leaf_input::host) {
+      // input is produced on host, where it already lives
+      memcpy(i, i_h, i_size);
+    }
+
+    sycl::cl_ulong tx_ts[1];
+
+    *(ts + 1) = merklize_zero_copy<H>(
+      q, i, i_size, leaf_cnt, o_d, o_size, leaf_cnt - 1, wg_size, tx_ts);
+
+    sycl::event evt_1 = q.memcpy(o_h, o_d, o_size);
+    evt_1.wait();
+
+    *(ts + 0) = ts_0 + tx_ts[0];
+    *(ts + 2) = time_event(evt_1);
+    *(ts + 3) = 0;
+
+    if (src == leaf_input::device || src == leaf_input::shared) {
+      pool.release(i);
+    } else if (src == leaf_input::pageable) {
+      std::free(i);
+    }
+    pool.release(i_h);
+    pool.release(o_h);
+    pool.release(o_d);
+    return;
+  }
+
+  // acquire resources, recycled across iterations
+  word_t* i_h = pool.allocate<word_t>(i_size, sycl::usm::alloc::host);
+  word_t* o_h = pool.allocate<word_t>(o_size, sycl::usm::alloc::host);
+  word_t* i_d = pool.allocate<word_t>(i_size, sycl::usm::alloc::device);
+  word_t* o_d = pool.allocate<word_t>(o_size, sycl::usm::alloc::device);
 
   // Set all intermediate nodes to zero bytes,
   //
@@ -95,66 +238,139 @@ benchmark_merklize(sycl::queue& q,
     memset(i_h, dis(gen), i_size); // prepare (random) input bytes
   }
 
-  sycl::cl_ulong ts_0, ts_1, ts_2;
+  sycl::cl_ulong ts_0 = 0, ts_1, ts_2 = 0, ts_3 = 0;
 
-  // copy input from host to device
-  sycl::event evt_0 = q.memcpy(i_d, i_h, i_size);
-  evt_0.wait();
-  // time host to device tx command
-  ts_0 = time_event(evt_0);
+  // pipelined merklization uploads input itself, segment by segment
+  if (engine != merklize_engine::pipelined) {
+    // copy input from host to device
+    sycl::event evt_0 = q.memcpy(i_d, i_h, i_size);
+    evt_0.wait();
+    // time host to device tx command
+    ts_0 = time_event(evt_0);
+  }
 
   // merklization, get sum of all dispatched kernel execution time
-  ts_1 = merklize(q, i_d, i_size, leaf_cnt, o_d, o_size, leaf_cnt - 1, wg_size);
+  switch (engine) {
+    case merklize_engine::pipelined: {
+      sycl::cl_ulong tx_ts[2];
 
-  // copy output from device to host
-  sycl::event evt_1 = q.memcpy(o_h, o_d, o_size);
-  evt_1.wait();
-  // time device to host data tx command
-  ts_2 = time_event(evt_1);
+      ts_1 = merklize_pipelined<H>(q,
+                                   i_h,
+                                   i_d,
+                                   i_size,
+                                   leaf_cnt,
+                                   o_d,
+                                   o_size,
+                                   leaf_cnt - 1,
+                                   wg_size,
+                                   engine_arg,
+                                   tx_ts);
+      ts_0 = tx_ts[0];
+      ts_3 = tx_ts[1];
+      break;
+    }
+    case merklize_engine::fused:
+      ts_1 = merklize_fused<H>(q,
+                               i_d,
+                               i_size,
+                               leaf_cnt,
+                               o_d,
+                               o_size,
+                               leaf_cnt - 1,
+                               wg_size,
+                               engine_arg);
+      break;
+    case merklize_engine::persistent:
+      ts_1 = merklize_persistent<H>(
+        q, i_d, i_size, leaf_cnt, o_d, o_size, leaf_cnt - 1, wg_size);
+      break;
+    case merklize_engine::hybrid:
+      ts_1 = merklize_hybrid<H>(q,
+                                i_d,
+                                i_size,
+                                leaf_cnt,
+                                o_d,
+                                o_size,
+                                leaf_cnt - 1,
+                                wg_size,
+                                engine_arg,
+                                cutover_lvl);
+      break;
+    case merklize_engine::arbitrary:
+      ts_1 = merklize_arbitrary<H>(q,
+                                   i_d,
+                                   i_size,
+                                   leaf_cnt,
+                                   o_d,
+                                   o_size,
+                                   intermediate_cnt(leaf_cnt),
+                                   wg_size,
+                                   static_cast<odd_node_policy>(engine_arg));
+      break;
+    case merklize_engine::batched:
+      ts_1 = merklize_batch<H>(q,
+                               i_d,
+                               i_size,
+                               engine_arg,
+                               leaf_cnt / engine_arg,
+                               o_d,
+                               o_size,
+                               wg_size);
+      break;
+    case merklize_engine::readback: {
+      sycl::cl_ulong tx_ts[2];
+
+      // first node is never copied back to host
+      memset(o_h, 0, o_size);
+
+      ts_1 = merklize_readback<H>(q,
+                                  i_d,
+                                  i_size,
+                                  leaf_cnt,
+                                  o_d,
+                                  o_size,
+                                  leaf_cnt - 1,
+                                  wg_size,
+                                  o_h,
+                                  tx_ts);
+      ts_2 = tx_ts[0];
+      ts_3 = tx_ts[1];
+      break;
+    }
+    case merklize_engine::autotuned:
+      ts_1 = merklize_tuned<H>(
+        q, i_d, i_size, leaf_cnt, o_d, o_size, leaf_cnt - 1, lvl_wg_sizes);
+      break;
+    default:
+      ts_1 = merklize<H>(
+        q, i_d, i_size, leaf_cnt, o_d, o_size, leaf_cnt - 1, wg_size);
+      break;
+  }
+
+  // level by level readback merklization already copied output back
+  if (engine != merklize_engine::readback) {
+    // copy output from device to host
+    sycl::event evt_1 = q.memcpy(o_h, o_d, o_size);
+    evt_1.wait();
+    // time device to host data tx command
+    ts_2 = time_event(evt_1);
+  }
 
   // ensuring that first digest bytes ( different for each SHA variant ) are
   // never touched by any work-items
-  for (size_t i = 0; i <
-
-#if defined SHA1
-                     (sha1::OUT_LEN_BYTES >> 2)
-#elif defined SHA2_224
-                     (sha2_224::OUT_LEN_BYTES >> 2)
-#elif defined SHA2_256
-                     (sha2_256::OUT_LEN_BYTES >> 2)
-#elif defined SHA2_384
-                     (sha2_384::OUT_LEN_BYTES >> 3)
-#elif defined SHA2_512
-                     (sha2_512::OUT_LEN_BYTES >> 3)
-#elif defined SHA2_512_224
-                     (32 >> 3)
-#elif defined SHA2_512_256
-                     (sha2_512_256::OUT_LEN_BYTES >> 3)
-#elif defined SHA3_256
-                     (sha3_256::OUT_LEN_BYTES)
-#elif defined SHA3_224
-                     (sha3_224::OUT_LEN_BYTES)
-#elif defined SHA3_384
-                     (sha3_384::OUT_LEN_BYTES)
-#elif defined SHA3_512
-                     (sha3_512::OUT_LEN_BYTES)
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-                     (keccak_256::OUT_LEN_BYTES)
-#endif
-
-         ;
-       i++) {
+  for (size_t i = 0; i < H::NODE_WORDS; i++) {
     assert(*(o_h + i) == 0);
   }
 
-  // ensure all acquired resources are deallocated too !
-  sycl::free(i_h, q);
-  sycl::free(o_h, q);
-  sycl::free(i_d, q);
-  sycl::free(o_d, q);
+  // ensure all acquired resources are given back to pool too !
+  pool.release(i_h);
+  pool.release(o_h);
+  pool.release(i_d);
+  pool.release(o_d);
 
   // all time in nanosecond level granularity
   *(ts + 0) = ts_0; // host to device data transfer time
   *(ts + 1) = ts_1; // total kernel execution cost
   *(ts + 2) = ts_2; // device to host data transfer time
+  *(ts + 3) = ts_3; // hidden host to device data transfer time
 }
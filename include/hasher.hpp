@@ -0,0 +1,682 @@
+#pragma once
+#include "keccak_256.hpp"
+#include "sha1.hpp"
+#include "sha2_224.hpp"
+#include "sha2_256.hpp"
+#include "sha2_384.hpp"
+#include "sha2_512.hpp"
+#include "sha2_512_224.hpp"
+#include "sha2_512_256.hpp"
+#include "sha3_224.hpp"
+#include "sha3_256.hpp"
+#include "sha3_384.hpp"
+#include "sha3_512.hpp"
+#include <bit>
+#include <cstring>
+
+// Hasher policies, one for each variant of 2-to-1 hash function, which can be
+// used for binary merklization; all merklization routines are templated over
+// one of these policies, so that all variants live in same binary, while each
+// kernel is fully specialized for chosen variant
+//
+// Each hasher policy is an empty type, carrying
+//
+// - `word_t`: word type, in which leaf/ intermediate nodes are represented
+// - `LEAF_PAIR_WORDS`: # -of words occupied by two consecutive leaf nodes i.e.
+// input to 2-to-1 hash function, when computing intermediate nodes living just
+// above leaf nodes
+// - `NODE_WORDS`: # -of words occupied by each intermediate node, on output
+// memory allocation
+// - `NODE_LEN_BYTES`: size of each intermediate node, on output memory
+// allocation, in bytes
+// - `DIGEST_LEN_BYTES`: size of each leaf node/ digest, in bytes
+// - `NAME`: human readable name of hash function
+// - `ID`: short name of hash function, used for choosing it at run-time
+// - `hash(in, out)`: 2-to-1 hash function, consuming LEAF_PAIR_WORDS -many
+// words, while producing NODE_WORDS -many words; for SHA1/ SHA2 variants,
+// input is read in place, as padding is known at compile-time ( see
+// `hash_node` of each variant )
+// - `hash_message(msg, len, digest)`: hashes `len` -bytes message, of arbitrary
+// length, producing NODE_WORDS -many words, which is how raw leaf data is
+// turned into leaf node
+//
+// Note, SHA2-512/224 intermediate nodes are 32 -bytes wide ( last 4 bytes are
+// never used ), while leaf nodes are tightly packed 28 -bytes digests
+//
+// SHA1/ SHA2 words are big-endian, while SHA3-256/384/512 & keccak256 ( 64 -bit
+// word ) words are 64 -bit keccak-p[1600, 24] state array lanes, each holding 8
+// consecutive digest bytes in little-endian order ( see `has_lane_words` ), so
+// that nodes are hashed without being assembled/ scattered byte-by-byte, while
+// node memory is still byte-for-byte same as standard digest; SHA3-224 ( 28
+// -bytes digest isn't lane aligned ) & keccak256 ( 32 -bit word ) work on bytes
+namespace hasher {
+
+struct sha1
+{
+  using word_t = sycl::uint;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha1::IN_LEN_BYTES >> 2;
+  static constexpr size_t NODE_WORDS = ::sha1::OUT_LEN_BYTES >> 2;
+  static constexpr size_t NODE_LEN_BYTES = ::sha1::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha1::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA1";
+  static constexpr const char* ID = "sha1";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha1::hash_node(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha1::hash_message(msg, len, digest);
+  }
+};
+
+struct sha2_224
+{
+  using word_t = sycl::uint;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha2_224::IN_LEN_BYTES >> 2;
+  static constexpr size_t NODE_WORDS = ::sha2_224::OUT_LEN_BYTES >> 2;
+  static constexpr size_t NODE_LEN_BYTES = ::sha2_224::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha2_224::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA2-224";
+  static constexpr const char* ID = "sha2_224";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha2_224::hash_node(in, out);
+  }
+
+  static inline void hash_rolling(const word_t* __restrict in,
+                                  word_t* const __restrict out)
+  {
+    ::sha2_224::hash_node_rolling(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha2_224::hash_message(msg, len, digest);
+  }
+};
+
+struct sha2_256
+{
+  using word_t = sycl::uint;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha2_256::IN_LEN_BYTES >> 2;
+  static constexpr size_t NODE_WORDS = ::sha2_256::OUT_LEN_BYTES >> 2;
+  static constexpr size_t NODE_LEN_BYTES = ::sha2_256::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha2_256::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA2-256";
+  static constexpr const char* ID = "sha2_256";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha2_256::hash_node(in, out);
+  }
+
+  static inline void hash_rolling(const word_t* __restrict in,
+                                  word_t* const __restrict out)
+  {
+    ::sha2_256::hash_node_rolling(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha2_256::hash_message(msg, len, digest);
+  }
+};
+
+struct sha2_384
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha2_384::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::sha2_384::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::sha2_384::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha2_384::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA2-384";
+  static constexpr const char* ID = "sha2_384";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha2_384::hash_node(in, out);
+  }
+
+  static inline void hash_rolling(const word_t* __restrict in,
+                                  word_t* const __restrict out)
+  {
+    ::sha2_384::hash_node_rolling(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha2_384::hash_message(msg, len, digest);
+  }
+};
+
+struct sha2_512
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha2_512::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::sha2_512::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::sha2_512::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha2_512::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA2-512";
+  static constexpr const char* ID = "sha2_512";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha2_512::hash_node(in, out);
+  }
+
+  static inline void hash_rolling(const word_t* __restrict in,
+                                  word_t* const __restrict out)
+  {
+    ::sha2_512::hash_node_rolling(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha2_512::hash_message(msg, len, digest);
+  }
+};
+
+struct sha2_512_224
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha2_512_224::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = 32 >> 3;
+  static constexpr size_t NODE_LEN_BYTES = 32;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha2_512_224::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA2-512/224";
+  static constexpr const char* ID = "sha2_512_224";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha2_512_224::hash_node(in, out);
+  }
+
+  static inline void hash_rolling(const word_t* __restrict in,
+                                  word_t* const __restrict out)
+  {
+    ::sha2_512_224::hash_node_rolling(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha2_512_224::hash_message(msg, len, digest);
+  }
+};
+
+struct sha2_512_256
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha2_512_256::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::sha2_512_256::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::sha2_512_256::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha2_512_256::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA2-512/256";
+  static constexpr const char* ID = "sha2_512_256";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha2_512_256::hash_node(in, out);
+  }
+
+  static inline void hash_rolling(const word_t* __restrict in,
+                                  word_t* const __restrict out)
+  {
+    ::sha2_512_256::hash_node_rolling(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha2_512_256::hash_message(msg, len, digest);
+  }
+};
+
+struct sha3_224
+{
+  using word_t = sycl::uchar;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha3_224::IN_LEN_BYTES;
+  static constexpr size_t NODE_WORDS = ::sha3_224::OUT_LEN_BYTES;
+  static constexpr size_t NODE_LEN_BYTES = ::sha3_224::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha3_224::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "SHA3-224";
+  static constexpr const char* ID = "sha3_224";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha3_224::hash(in, out);
+  }
+
+  static inline void hash_tree(const word_t* __restrict in,
+                               word_t* const __restrict out)
+  {
+    ::sha3_224::hash_tree(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha3_224::hash_message(msg, len, digest);
+  }
+};
+
+struct sha3_256
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha3_256::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::sha3_256::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::sha3_256::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha3_256::OUT_LEN_BYTES;
+
+  static constexpr bool LANE_WORDS = true;
+
+  static constexpr const char* NAME = "SHA3-256";
+  static constexpr const char* ID = "sha3_256";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha3_256::hash_lanes(in, out);
+  }
+
+  static inline void hash_tree(const word_t* __restrict in,
+                               word_t* const __restrict out)
+  {
+    ::sha3_256::hash_tree(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha3_256::hash_message(
+      msg, len, reinterpret_cast<sycl::uchar*>(digest));
+  }
+};
+
+struct sha3_384
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha3_384::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::sha3_384::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::sha3_384::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha3_384::OUT_LEN_BYTES;
+
+  static constexpr bool LANE_WORDS = true;
+
+  static constexpr const char* NAME = "SHA3-384";
+  static constexpr const char* ID = "sha3_384";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha3_384::hash_lanes(in, out);
+  }
+
+  static inline void hash_tree(const word_t* __restrict in,
+                               word_t* const __restrict out)
+  {
+    ::sha3_384::hash_tree(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha3_384::hash_message(
+      msg, len, reinterpret_cast<sycl::uchar*>(digest));
+  }
+};
+
+struct sha3_512
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::sha3_512::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::sha3_512::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::sha3_512::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::sha3_512::OUT_LEN_BYTES;
+
+  static constexpr bool LANE_WORDS = true;
+
+  static constexpr const char* NAME = "SHA3-512";
+  static constexpr const char* ID = "sha3_512";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::sha3_512::hash_lanes(in, out);
+  }
+
+  static inline void hash_tree(const word_t* __restrict in,
+                               word_t* const __restrict out)
+  {
+    ::sha3_512::hash_tree(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::sha3_512::hash_message(
+      msg, len, reinterpret_cast<sycl::uchar*>(digest));
+  }
+};
+
+// keccak256 2-to-1 hash, where each lane of keccak-p[1600, 24] state array is
+// represented using a 64 -bit word
+struct keccak_256_u64
+{
+  using word_t = sycl::ulong;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::keccak_256::IN_LEN_BYTES >> 3;
+  static constexpr size_t NODE_WORDS = ::keccak_256::OUT_LEN_BYTES >> 3;
+  static constexpr size_t NODE_LEN_BYTES = ::keccak_256::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::keccak_256::OUT_LEN_BYTES;
+
+  static constexpr bool LANE_WORDS = true;
+
+  static constexpr const char* NAME = "KECCAK-256 ( 64 -bit word )";
+  static constexpr const char* ID = "keccak_256_u64";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::keccak_256::hash_lanes(in, out);
+  }
+
+  static inline void hash_tree(const word_t* __restrict in,
+                               word_t* const __restrict out)
+  {
+    ::keccak_256::hash_tree(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::keccak_256::hash_message(
+      msg, len, reinterpret_cast<sycl::uchar*>(digest));
+  }
+};
+
+// keccak256 2-to-1 hash, where each lane of keccak-p[1600, 24] state array is
+// represented using two 32 -bit words, in bit interleaved form
+struct keccak_256_u32
+{
+  using word_t = sycl::uchar;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::keccak_256::IN_LEN_BYTES;
+  static constexpr size_t NODE_WORDS = ::keccak_256::OUT_LEN_BYTES;
+  static constexpr size_t NODE_LEN_BYTES = ::keccak_256::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::keccak_256::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "KECCAK-256 ( 32 -bit word )";
+  static constexpr const char* ID = "keccak_256_u32";
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::keccak_256::hash_u32(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::keccak_256::hash_message(msg, len, digest);
+  }
+};
+
+// keccak256 2-to-1 hash, which keeps intermediate nodes of tree in bit
+// interleaved form ( see `hash_interleaved` in keccak_256.hpp ), as eight 32
+// -bit words, so that intermediate nodes are converted neither from nor to
+// standard form, on any tree level; only leaf nodes ( standard 32 -bytes
+// digests ) are converted, when they're hashed, using `hash_leaves`
+//
+// It's not one of run-time selectable variants, as intermediate nodes are not
+// standard digests; see `merklize_interleaved` in merklize_interleaved.hpp,
+// which converts root ( and any exported node ) back to standard form
+struct keccak_256_interleaved
+{
+  using word_t = sycl::uint;
+
+  static constexpr size_t LEAF_PAIR_WORDS = ::keccak_256::IN_LEN_BYTES >> 2;
+  static constexpr size_t NODE_WORDS = ::keccak_256::OUT_LEN_BYTES >> 2;
+  static constexpr size_t NODE_LEN_BYTES = ::keccak_256::OUT_LEN_BYTES;
+  static constexpr size_t DIGEST_LEN_BYTES = ::keccak_256::OUT_LEN_BYTES;
+
+  static constexpr const char* NAME = "KECCAK-256 ( bit interleaved tree )";
+  static constexpr const char* ID = "keccak_256_bi";
+
+  // leaf nodes are standard digests, given as 32 -bit words
+  static inline void hash_leaves(const word_t* __restrict in,
+                                 word_t* const __restrict out)
+  {
+    ::keccak_256::hash_leaves_interleaved(
+      reinterpret_cast<const sycl::uchar*>(in), out);
+  }
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    ::keccak_256::hash_interleaved(in, out);
+  }
+
+  static inline void hash_message(const sycl::uchar* __restrict msg,
+                                  size_t len,
+                                  word_t* const __restrict digest)
+  {
+    ::keccak_256::hash_message(
+      msg, len, reinterpret_cast<sycl::uchar*>(digest));
+  }
+};
+
+// Whether hasher policy `H` is one of SHA2 variants, which also carry
+// `hash_rolling(in, out)`, computing same 2-to-1 hash using register-lean
+// compression core ( see `hash_node_rolling` in sha2.hpp )
+template<typename H>
+constexpr bool has_rolling_core = requires { &H::hash_rolling; };
+
+// Whether words of hasher policy `H` are little-endian 64 -bit keccak lanes,
+// in which case leaf/ intermediate nodes are laid out in memory same as
+// standard digests, so no byte order conversion is required at leaf ingestion/
+// result export boundaries
+template<typename H>
+constexpr bool has_lane_words = requires { H::LANE_WORDS; };
+
+static_assert(std::endian::native == std::endian::little,
+              "keccak lanes are stored in native byte order");
+
+// Whether hasher policy `H` is one of SHA3 variants ( or keccak256, using 64
+// -bit word ), which also carry `hash_tree(in, out)`, computing same 2-to-1
+// hash using keccak-p[1600, 24] permutation specialized for tree hashing ( see
+// `keccak_p_tree` in sha3.hpp )
+template<typename H>
+constexpr bool has_tree_permutation = requires { &H::hash_tree; };
+
+// Adapts SHA2 hasher policy `H`, so that its 2-to-1 hash function uses
+// register-lean compression core, which keeps message schedule in 16 -word
+// circular window & unrolls all rounds at compile-time, instead of
+// materializing whole message schedule; it's kept around for comparing both
+// compression cores, using same merklization routines
+template<typename H>
+struct sha2_rolling : H
+{
+  static_assert(has_rolling_core<H>);
+
+  using word_t = typename H::word_t;
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    H::hash_rolling(in, out);
+  }
+};
+
+// Adapts SHA3/ keccak256 hasher policy `H`, so that its 2-to-1 hash function
+// uses keccak-p[1600, 24] permutation specialized for tree hashing, which
+// renames lanes instead of copying them, complements lanes to cut NOTs in `χ`,
+// folds known-zero input lanes & skips lanes not reaching digest; it's kept
+// around for comparing both permutations, using same merklization routines
+template<typename H>
+struct keccak_tree : H
+{
+  static_assert(has_tree_permutation<H>);
+
+  using word_t = typename H::word_t;
+
+  static inline void hash(const word_t* __restrict in,
+                          word_t* const __restrict out)
+  {
+    H::hash_tree(in, out);
+  }
+};
+
+// Run-time identifier of each hasher policy, which is used for choosing hash
+// function per merklization request, while all variants are compiled into same
+// binary
+enum class variant
+{
+  sha1,
+  sha2_224,
+  sha2_256,
+  sha2_384,
+  sha2_512,
+  sha2_512_224,
+  sha2_512_256,
+  sha3_224,
+  sha3_256,
+  sha3_384,
+  sha3_512,
+  keccak_256_u64,
+  keccak_256_u32,
+};
+
+// All variants, in order of their declaration
+constexpr variant VARIANTS[] = {
+  variant::sha1,           variant::sha2_224,       variant::sha2_256,
+  variant::sha2_384,       variant::sha2_512,       variant::sha2_512_224,
+  variant::sha2_512_256,   variant::sha3_224,       variant::sha3_256,
+  variant::sha3_384,       variant::sha3_512,       variant::keccak_256_u64,
+  variant::keccak_256_u32,
+};
+
+// Invokes `f` with an instance of hasher policy identified by `v`, so that `f`
+// ( generic lambda ) gets instantiated for all hasher policies, while only one
+// of them is called at run-time; this is only place where run-time choice of
+// hash function is converted to compile-time one
+//
+// Use as
+//
+// hasher::dispatch(v, [&](auto h) {
+//   using H = decltype(h);
+//   merklize<H>( ... );
+// });
+template<typename F>
+inline decltype(auto)
+dispatch(variant v, F&& f)
+{
+  switch (v) {
+    case variant::sha1:
+      return f(sha1{});
+    case variant::sha2_224:
+      return f(sha2_224{});
+    case variant::sha2_256:
+      return f(sha2_256{});
+    case variant::sha2_384:
+      return f(sha2_384{});
+    case variant::sha2_512:
+      return f(sha2_512{});
+    case variant::sha2_512_224:
+      return f(sha2_512_224{});
+    case variant::sha2_512_256:
+      return f(sha2_512_256{});
+    case variant::sha3_224:
+      return f(sha3_224{});
+    case variant::sha3_256:
+      return f(sha3_256{});
+    case variant::sha3_384:
+      return f(sha3_384{});
+    case variant::sha3_512:
+      return f(sha3_512{});
+    case variant::keccak_256_u64:
+      return f(keccak_256_u64{});
+    default:
+      return f(keccak_256_u32{});
+  }
+}
+
+// Human readable name of hash function identified by `v`
+inline const char*
+name(variant v)
+{
+  return dispatch(v, [](auto h) { return decltype(h)::NAME; });
+}
+
+// Short name of hash function identified by `v`
+inline const char*
+id(variant v)
+{
+  return dispatch(v, [](auto h) { return decltype(h)::ID; });
+}
+
+// Finds hash function variant by its short name ( see `ID` of hasher
+// policies ), returning false if no such variant exists
+inline bool
+from_id(const char* id_, variant* const v)
+{
+  for (variant v_ : VARIANTS) {
+    if (std::strcmp(id_, id(v_)) == 0) {
+      *v = v_;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}
@@ -70,6 +70,71 @@ to_state_array(const sycl::uchar* __restrict in,
   }
 }
 
+// Prepares 5 x 5 x 64 keccak state array from input, given as eight 64 -bit
+// lanes, which are placed in state array as they are, instead of being
+// assembled byte-by-byte, as above; see `hash_lanes`
+void
+to_state_array(const sycl::ulong* __restrict in,
+               sycl::ulong* const __restrict state)
+{
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = in[i];
+  }
+
+  // same ( keccak-256 ) padding bits as above
+  state[8] = 0b1ull;
+
+#pragma unroll 7
+  for (size_t i = 9; i < 16; i++) {
+    state[i] = 0ull;
+  }
+
+  state[16] = 9223372036854775808ull;
+
+#pragma unroll 8
+  for (size_t i = 17; i < 25; i++) {
+    state[i] = 0ull;
+  }
+}
+
+// Writes lanes [8, 25) of bit interleaved keccak state array, which only carry
+// padding of 64 -bytes input message ( see padding rule defined under
+// `Keccak[r, c](M)` in section 1.1 of
+// https://keccak.team/files/Keccak-implementation-3.2.pdf ), where both padded
+// 1 -bits ( lane 8's LSB & lane 16's MSB ) are converted to bit interleaved
+// form at compile-time
+void
+pad_state_array(sycl::uint* const state)
+{
+  // ! read right to left, so lane 16 is actually 1 << 63 !
+  constexpr uint64_t lane_8 = 0b1ull;
+  constexpr uint64_t lane_16 = 9223372036854775808ull;
+
+  constexpr sycl::uint lane_8_even = gather_even_bits(lane_8);
+  constexpr sycl::uint lane_8_odd = gather_even_bits(lane_8 >> 1);
+  constexpr sycl::uint lane_16_even = gather_even_bits(lane_16);
+  constexpr sycl::uint lane_16_odd = gather_even_bits(lane_16 >> 1);
+
+  state[16] = lane_8_even;
+  state[17] = lane_8_odd;
+
+#pragma unroll 7
+  for (size_t i = 9; i < 16; i++) {
+    state[(i << 1) + 0] = 0u;
+    state[(i << 1) + 1] = 0u;
+  }
+
+  state[32] = lane_16_even;
+  state[33] = lane_16_odd;
+
+#pragma unroll 8
+  for (size_t i = 17; i < 25; i++) {
+    state[(i << 1) + 0] = 0u;
+    state[(i << 1) + 1] = 0u;
+  }
+}
+
 // From input byte array ( = 64 bytes ) preparing 5 x 5 x 64 keccak state array
 // as twenty five 64 -bit unsigned integers
 //
@@ -106,50 +171,13 @@ to_state_array(const sycl::uchar* __restrict in,
                           static_cast<sycl::ulong>(in[(i << 3) + 0]) << 0;
 
     uint32_t even, odd;
-    to_bit_interleaved(word, &even, &odd);
+    to_bit_interleaved_fast(word, &even, &odd);
 
     state[(i << 1) + 0] = even;
     state[(i << 1) + 1] = odd;
   }
 
-  // see how 0b01 is padded to input message; following keccak-256
-  // implementation guide
-  // https://keccak.team/files/Keccak-implementation-3.2.pdf 's section 1.1
-  // where `Keccak[r, c](M)` is defined ( spcifically padding rule block in
-  // pseudocode, at very end of mentioned section )
-  //
-  // ! read right to left !
-  uint64_t word = 0b1ull;
-  uint32_t even, odd;
-  to_bit_interleaved(word, &even, &odd);
-
-  state[16] = even;
-  state[17] = odd;
-
-#pragma unroll 7
-  for (size_t i = 9; i < 16; i++) {
-    state[(i << 1) + 0] = 0u;
-    state[(i << 1) + 1] = 0u;
-  }
-
-  // this 1 is added to input message bits due to padding requirement
-  // defined in keccak-256 implementation guide
-  // https://keccak.team/files/Keccak-implementation-3.2.pdf 's section 1.1
-  // where `Keccak[r, c](M)` is defined ( spcifically padding rule block in
-  // pseudocode, at very end of mentioned section )
-  //
-  // ! read right to left, so it's actually 1 << 63 !
-  word = 9223372036854775808ull;
-  to_bit_interleaved(word, &even, &odd);
-
-  state[32] = even;
-  state[33] = odd;
-
-#pragma unroll 8
-  for (size_t i = 17; i < 25; i++) {
-    state[(i << 1) + 0] = 0u;
-    state[(i << 1) + 1] = 0u;
-  }
+  pad_state_array(state);
 }
 
 // From absorbed hash state array of dimension 5 x 5 x 64, produces 32 -bytes
@@ -195,7 +223,7 @@ to_digest_bytes(const uint32_t* __restrict in,
     const sycl::uint lane_even = in[(i << 1) + 0];
     const sycl::uint lane_odd = in[(i << 1) + 1];
 
-    const uint64_t word = from_bit_interleaved(lane_even, lane_odd);
+    const uint64_t word = from_bit_interleaved_fast(lane_even, lane_odd);
 
     digest[(i << 3) + 0] = static_cast<sycl::uchar>((word >> 0) & 0xffull);
     digest[(i << 3) + 1] = static_cast<sycl::uchar>((word >> 8) & 0xffull);
@@ -256,4 +284,115 @@ hash_u32(const sycl::uchar* __restrict in, sycl::uchar* const __restrict digest)
   to_digest_bytes(state, digest);
 }
 
+// Keccak-256 2-to-1 hasher, where input is eight 64 -bit lanes ( = 64 bytes ),
+// which is hashed to produce four 64 -bit lanes ( = 32 -bytes digest )
+//
+// Each lane holds 8 consecutive bytes in little-endian order, which is how
+// keccak-p[1600, 24] state array lanes are defined, so in memory of a little
+// endian device, lanes are byte-for-byte same as standard digest, while no
+// byte is assembled/ scattered when hashing
+void
+hash_lanes(const sycl::ulong* __restrict in,
+           sycl::ulong* const __restrict digest)
+{
+  sycl::ulong state[25];
+
+  to_state_array(in, state);
+  keccak_p(state);
+
+#pragma unroll 4
+  for (size_t i = 0; i < 4; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Same as `hash_lanes`, but uses keccak-p[1600, 24] permutation specialized
+// for tree hashing ( see `keccak_p_tree` ), where only input & padding lanes (
+// = lanes [0, 9) & 16 ) are set, while only four lanes of digest are computed
+// in last round
+void
+hash_tree(const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  constexpr uint32_t LIVE = ((1u << 9) - 1u) | (1u << 16);
+
+  sycl::ulong state[25];
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = in[i];
+  }
+
+  state[8] = 0b1ull;
+  state[16] = 9223372036854775808ull;
+
+  keccak_p_tree<LIVE, 4>(state);
+
+#pragma unroll 4
+  for (size_t i = 0; i < 4; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Computes 256 -bit Keccak-256 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, using sponge
+// construction with rate of 136 -bytes
+//
+// See section 1.1 of https://keccak.team/files/Keccak-implementation-3.2.pdf
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uchar* const __restrict digest)
+{
+  sponge<136, 0b1, 32>(msg, len, digest);
+}
+
+// Keccak-256 2-to-1 hasher, which is same as `hash_u32`, except that 32 -bytes
+// digest is kept in bit interleaved form, as first four lanes of permuted state
+// array ( eight 32 -bit words ), so that next tree level can consume it
+// directly, using `hash_interleaved`
+//
+// For more info on bit interleaved representation, see section 2.1 of
+// https://keccak.team/files/Keccak-implementation-3.2.pdf
+void
+hash_leaves_interleaved(const sycl::uchar* __restrict in,
+                        sycl::uint* const __restrict digest)
+{
+  sycl::uint state[50];
+
+  to_state_array(in, state);
+  keccak_p(state);
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Keccak-256 2-to-1 hasher, where input is two digests, each kept in bit
+// interleaved form ( = sixteen 32 -bit words ), which are placed as first eight
+// lanes of state array as they're, without any conversion, while 32 -bytes
+// digest is also produced in bit interleaved form ( see
+// `hash_leaves_interleaved` ); use `to_digest_bytes` for converting it to
+// standard byte form
+void
+hash_interleaved(const sycl::uint* __restrict in,
+                 sycl::uint* const __restrict digest)
+{
+  sycl::uint state[50];
+
+#pragma unroll 16
+  for (size_t i = 0; i < 16; i++) {
+    state[i] = in[i];
+  }
+
+  pad_state_array(state);
+  keccak_p(state);
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    digest[i] = state[i];
+  }
+}
+
 }
@@ -1,87 +1,331 @@
 #pragma once
+#include "hasher.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+// Word level view of leaf/ intermediate nodes of binary merkle tree, along
+// with 2-to-1 hashing helpers, which are shared by all merklization kernels
+// ( see `merklize` below & `merklize_fused` in merklize_fused.hpp )
+//
+// All of them are templated over hasher policy `H`, defined in hasher.hpp
+namespace node {
+
+// Computes an intermediate node living just above leaf nodes, by 2-to-1
+// hashing two consecutive leaf nodes ( = LEAF_PAIR_WORDS -many words ), while
+// digest is written to NODE_WORDS -many words of output memory
+//
+// Hasher policy may carry its own `hash_leaves`, when intermediate nodes are
+// represented differently than leaf nodes ( see `keccak_256_interleaved` )
+template<typename H>
+inline void
+hash_leaves(const typename H::word_t* __restrict in,
+            typename H::word_t* const __restrict out)
+{
+  if constexpr (requires { &H::hash_leaves; }) {
+    H::hash_leaves(in, out);
+  } else {
+    H::hash(in, out);
+  }
+}
+
+// Computes an intermediate node by 2-to-1 hashing two consecutive intermediate
+// nodes ( = 2 * NODE_WORDS -many words ), while digest is written to
+// NODE_WORDS -many words of output memory
+//
+// Only for SHA2-512/224 it's different from `hash_leaves`, because
+// intermediate nodes are 32 -bytes wide, so first 28 -bytes of both of them
+// are to be extracted & concatenated before 2-to-1 hashing
+template<typename H>
+inline void
+hash_nodes(const typename H::word_t* __restrict in,
+           typename H::word_t* const __restrict out)
+{
+  if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+    static_assert(std::is_base_of_v<hasher::sha2_512_224, H>,
+                  "only SHA2-512/224 nodes are wider than digests");
+
+    // first three 64 -bit words of first SHA2-512/224 digest are taken as they
+    // are, then MSB 32 -bits of last word of first digest and all (
+    // meaningful ) 224 -bits of second digest are concatenated into remaining
+    // four 64 -bit words
+    sycl::ulong in_words[7];
+
+    in_words[0] = in[0];
+    in_words[1] = in[1];
+    in_words[2] = in[2];
+    in_words[3] = (((in[3] >> 32) & 0xfffffffful) << 32) |
+                  ((in[4] >> 32) & 0xfffffffful);
+    in_words[4] =
+      ((in[4] & 0xfffffffful) << 32) | ((in[5] >> 32) & 0xfffffffful);
+    in_words[5] =
+      ((in[5] & 0xfffffffful) << 32) | ((in[6] >> 32) & 0xfffffffful);
+    in_words[6] =
+      ((in[6] & 0xfffffffful) << 32) | ((in[7] >> 32) & 0xfffffffful);
+
+    H::hash(in_words, out);
+  } else {
+    H::hash(in, out);
+  }
+}
+
+// Copies first leaf node of two consecutive leaf nodes ( = LEAF_PAIR_WORDS
+// -many words ) into NODE_WORDS -many words of output memory, so that it can be
+// placed among intermediate nodes
+//
+// Only for SHA2-512/224 last 32 -bits of output memory are zeroed, as leaf
+// nodes are tightly packed 28 -bytes digests
+template<typename H>
+inline void
+leaf_to_node(const typename H::word_t* __restrict in,
+             typename H::word_t* const __restrict out)
+{
+#pragma unroll 8
+  for (size_t i = 0; i < H::NODE_WORDS; i++) {
+    out[i] = in[i];
+  }
+
+  if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+    out[H::NODE_WORDS - 1] &= 0xffffffff00000000ul;
+  }
+}
+
+// Checks whether two nodes ( NODE_WORDS -many words each ) are same
+//
+// Only for SHA2-512/224 last 32 -bits of nodes are not compared, as they're
+// not part of 28 -bytes digest, which is why computed intermediate nodes may
+// have anything there
+template<typename H>
+inline bool
+equal(const typename H::word_t* const a, const typename H::word_t* const b)
+{
+  bool eq = true;
+
+#pragma unroll 8
+  for (size_t i = 0; i < H::NODE_WORDS - 1; i++) {
+    eq &= a[i] == b[i];
+  }
+
+  if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+    constexpr sycl::ulong mask = 0xffffffff00000000ul;
+    eq &= (a[H::NODE_WORDS - 1] & mask) == (b[H::NODE_WORDS - 1] & mask);
+  } else {
+    eq &= a[H::NODE_WORDS - 1] == b[H::NODE_WORDS - 1];
+  }
+
+  return eq;
+}
+
+// Extracts leaf node at index `idx` from consecutive pairs of leaf nodes, into
+// NODE_WORDS -many words, so that it can be placed among intermediate nodes
+//
+// Only for SHA2-512/224 second leaf node of a pair is not word aligned, so it's
+// reassembled from 64 -bit words it's spread over
+template<typename H>
+inline void
+leaf_at(const typename H::word_t* const __restrict leaf_nodes,
+        size_t idx,
+        typename H::word_t* const __restrict out)
+{
+  const typename H::word_t* in = leaf_nodes + (idx >> 1) * H::LEAF_PAIR_WORDS;
+
+  if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+    if ((idx & 1) == 0) {
+      leaf_to_node<H>(in, out);
+    } else {
+      out[0] = (in[3] << 32) | (in[4] >> 32);
+      out[1] = (in[4] << 32) | (in[5] >> 32);
+      out[2] = (in[5] << 32) | (in[6] >> 32);
+      out[3] = in[6] << 32;
+    }
+  } else {
+    leaf_to_node<H>(in + (idx & 1) * H::NODE_WORDS, out);
+  }
+}
+
+// Places leaf node `leaf` ( NODE_WORDS -many words ) at index `idx` of
+// consecutive pairs of leaf nodes, which is inverse of `leaf_at`
+//
+// Only for SHA2-512/224 leaf nodes of a pair share one 64 -bit word, so other
+// leaf node of that pair is kept as it is, while placing this one
+template<typename H>
+inline void
+put_leaf_at(const typename H::word_t* const __restrict leaf,
+            size_t idx,
+            typename H::word_t* const __restrict leaf_nodes)
+{
+  typename H::word_t* out = leaf_nodes + (idx >> 1) * H::LEAF_PAIR_WORDS;
+
+  if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+    if ((idx & 1) == 0) {
+      out[0] = leaf[0];
+      out[1] = leaf[1];
+      out[2] = leaf[2];
+      out[3] = (leaf[3] & 0xffffffff00000000ul) | (out[3] & 0xfffffffful);
+    } else {
+      out[3] = (out[3] & 0xffffffff00000000ul) | (leaf[0] >> 32);
+      out[4] = (leaf[0] << 32) | (leaf[1] >> 32);
+      out[5] = (leaf[1] << 32) | (leaf[2] >> 32);
+      out[6] = (leaf[2] << 32) | (leaf[3] >> 32);
+    }
+  } else {
+#pragma unroll 8
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      out[(idx & 1) * H::NODE_WORDS + i] = leaf[i];
+    }
+  }
+}
+
+}
+
+// Kernel names, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationPhase0;
+template<typename H>
+class kernelBinaryMerklizationPhase1;
+
+// Enqueues first phase of `merklize`, where leaf node pairs [pair_off, pair_off
+// + pair_cnt) are 2-to-1 hashed into intermediate nodes living just above leaf
+// nodes, of binary merkle tree having `leaf_cnt` -many leaf nodes, after all
+// events of `deps` are complete
+//
+// `pair_cnt` must be multiple of `wg_size`, so that all dispatched work-groups
+// have equal many active work-items
+template<typename H>
+sycl::event
+merklize_phase0(sycl::queue& q,
+                const typename H::word_t* __restrict leaf_nodes,
+                size_t leaf_cnt,
+                typename H::word_t* const __restrict intermediates,
+                size_t pair_off,
+                size_t pair_cnt,
+                size_t wg_size,
+                const std::vector<sycl::event>& deps)
+{
+  assert(pair_cnt % wg_size == 0);
+
+  // # -of words ( 32 -bit/ 64 -bit unsigned integers or bytes, depending upon
+  // SHA variant ), which are placed on output memory allocation, for
+  // intermediate nodes living just above leaf nodes
+  const size_t i_offset = pair_off * H::LEAF_PAIR_WORDS;
+  const size_t o_offset = ((leaf_cnt >> 1) + pair_off) * H::NODE_WORDS;
+
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+
+    h.parallel_for<kernelBinaryMerklizationPhase0<H>>(
+      sycl::nd_range<1>{ sycl::range<1>{ pair_cnt },
+                         sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) {
+        const size_t idx = it.get_global_linear_id();
+
+        const size_t in_idx = idx * H::LEAF_PAIR_WORDS;
+        const size_t out_idx = idx * H::NODE_WORDS;
+
+        node::hash_leaves<H>(leaf_nodes + i_offset + in_idx,
+                             intermediates + o_offset + out_idx);
+      });
+  });
+}
 
-#if !(defined SHA1 || defined SHA2_224 || defined SHA2_256 ||                  \
-      defined SHA2_384 || defined SHA2_512 || defined SHA2_512_224 ||          \
-      defined SHA2_512_256 || defined SHA3_256 || defined SHA3_224 ||          \
-      defined SHA3_384 || defined SHA3_512 || defined KECCAK_256_U64 ||        \
-      defined KECCAK_256_U32)
-#define SHA2_256
-#endif
-
-#if defined SHA1
-#include "sha1.hpp"
-#pragma message "Choosing to compile Merklization with SHA1 !"
-#elif defined SHA2_224
-#include "sha2_224.hpp"
-#pragma message "Choosing to compile Merklization with SHA2-224 !"
-#elif defined SHA2_256
-#include "sha2_256.hpp"
-#pragma message "Choosing to compile Merklization with SHA2-256 !"
-#elif defined SHA2_384
-#include "sha2_384.hpp"
-#pragma message "Choosing to compile Merklization with SHA2-384 !"
-#elif defined SHA2_512
-#include "sha2_512.hpp"
-#pragma message "Choosing to compile Merklization with SHA2-512 !"
-#elif defined SHA2_512_224
-#include "sha2_512_224.hpp"
-#pragma message "Choosing to compile Merklization with SHA2-512/224 !"
-#elif defined SHA2_512_256
-#include "sha2_512_256.hpp"
-#pragma message "Choosing to compile Merklization with SHA2-512/256 !"
-#elif defined SHA3_256
-#include "sha3_256.hpp"
-#pragma message "Choosing to compile Merklization with SHA3-256 !"
-#elif defined SHA3_224
-#include "sha3_224.hpp"
-#pragma message "Choosing to compile Merklization with SHA3-224 !"
-#elif defined SHA3_384
-#include "sha3_384.hpp"
-#pragma message "Choosing to compile Merklization with SHA3-384 !"
-#elif defined SHA3_512
-#include "sha3_512.hpp"
-#pragma message "Choosing to compile Merklization with SHA3-512 !"
-#elif defined KECCAK_256_U64
-#include "keccak_256.hpp"
-#pragma message                                                                \
-  "Choosing to compile Merklization with KECCAK-256 ( 64 -bit word ) !"
-#elif defined KECCAK_256_U32
-#include "keccak_256.hpp"
-#pragma message                                                                \
-  "Choosing to compile Merklization with KECCAK-256 ( 32 -bit word ) !"
-#endif
+// Enqueues remaining phase of `merklize`, where intermediate nodes are
+// computed level by level, from already computed intermediate nodes living
+// just above leaf nodes, of binary merkle tree having `leaf_cnt` -many leaf
+// nodes, one kernel dispatch per level
+//
+// Level having 2 ^ k -many nodes is dispatched with work-group size
+// `lvl_wg_sizes[k]`, which must be power of 2 and <= 2 ^ k, so that each level
+// can use work-group size tuned for its width
+//
+// First dispatch round depends on all events of `evts`, while event of each
+// dispatch round is appended to `evts`, so last one computes root
+template<typename H>
+void
+merklize_phase1(sycl::queue& q,
+                size_t leaf_cnt,
+                typename H::word_t* const __restrict intermediates,
+                const size_t* const lvl_wg_sizes,
+                std::vector<sycl::event>* const evts)
+{
+  const size_t work_item_cnt = leaf_cnt >> 1;
+  const size_t o_offset = work_item_cnt * H::NODE_WORDS;
+
+  // these many kernel dispatch rounds still remaining
+  const size_t rounds =
+    static_cast<size_t>(sycl::log2(static_cast<double>(work_item_cnt)));
+
+  const std::vector<sycl::event> deps = *evts;
+
+  for (size_t r = 0; r < rounds; r++) {
+    // multiple rounds of kernel dispatches, where intermediate nodes are being
+    // computed from already computed (in previous dispatch round) intermediate
+    // nodes
+    sycl::event evt_1 = q.submit([&](sycl::handler& h) {
+      // note, dependency chain being built !
+      //
+      // each dispatch round depends on previously enqueued dispatch round
+      if (r == 0) {
+        h.depends_on(deps);
+      } else {
+        h.depends_on(evts->back());
+      }
+
+      // this round computes level having 2 ^ (rounds - r - 1) -many nodes
+      const size_t work_item_cnt_ = work_item_cnt >> (r + 1);
+      const size_t wg_size_ = lvl_wg_sizes[rounds - r - 1];
+
+      const size_t i_offset_ = o_offset >> r;
+      const size_t o_offset_ = i_offset_ >> 1;
+
+      h.parallel_for<kernelBinaryMerklizationPhase1<H>>(
+        sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt_ },
+                           sycl::range<1>{ wg_size_ } },
+        [=](sycl::nd_item<1> it) {
+          const size_t idx = it.get_global_linear_id();
+
+          const size_t in_idx = idx * (H::NODE_WORDS << 1);
+          const size_t out_idx = idx * H::NODE_WORDS;
+
+          node::hash_nodes<H>(intermediates + i_offset_ + in_idx,
+                              intermediates + o_offset_ + out_idx);
+        });
+    });
+    evts->push_back(evt_1);
+  }
+}
+
+// Enqueues remaining phase of `merklize`, where all levels use work-group size
+// `wg_size`, unless level is narrower than that; see above routine
+template<typename H>
+void
+merklize_phase1(sycl::queue& q,
+                size_t leaf_cnt,
+                typename H::word_t* const __restrict intermediates,
+                size_t wg_size,
+                std::vector<sycl::event>* const evts)
+{
+  size_t lvl_wg_sizes[64];
+  for (size_t k = 0; k < 64; k++) {
+    lvl_wg_sizes[k] = std::min(wg_size, 1ul << k);
+  }
+
+  merklize_phase1<H>(q, leaf_cnt, intermediates, lvl_wg_sizes, evts);
+}
 
 // Binary merklization --- collects motivation from
 // https://github.com/itzmeanjan/blake3/blob/e2a1340/include/merklize.hpp#L4-L12
 //
-// Choice of SHA variant as 2-to-1 hash function is compile-time decision using
-// preprocessor directives, while default choice is SHA2-256
+// Choice of SHA variant as 2-to-1 hash function is compile-time decision, made
+// using hasher policy `H` ( see hasher.hpp ), so that all kernels are fully
+// specialized for chosen variant; for run-time choice of SHA variant, see
+// overload of `merklize` below
+template<typename H>
 sycl::cl_ulong
 merklize(sycl::queue& q,
-
-#if defined SHA1 || defined SHA2_224 || defined SHA2_256
-         const sycl::uint* __restrict leaf_nodes,
-#elif defined SHA2_384 || defined SHA2_512 || defined SHA2_512_224 ||          \
-  defined SHA2_512_256
-         const sycl::ulong* __restrict leaf_nodes,
-#elif defined SHA3_256 || defined SHA3_224 || defined SHA3_384 ||              \
-  defined SHA3_512 || defined KECCAK_256_U64 || defined KECCAK_256_U32
-         const sycl::uchar* __restrict leaf_nodes,
-#endif
-
+         const typename H::word_t* __restrict leaf_nodes,
          size_t i_size, // leaf nodes size in bytes
          size_t leaf_cnt,
-
-#if defined SHA1 || defined SHA2_224 || defined SHA2_256
-         sycl::uint* const __restrict intermediates,
-#elif defined SHA2_384 || defined SHA2_512 || defined SHA2_512_224 ||          \
-  defined SHA2_512_256
-         sycl::ulong* const __restrict intermediates,
-#elif defined SHA3_256 || defined SHA3_224 || defined SHA3_384 ||              \
-  defined SHA3_512 || defined KECCAK_256_U64 || defined KECCAK_256_U32
-         sycl::uchar* const __restrict intermediates,
-#endif
-
+         typename H::word_t* const __restrict intermediates,
          size_t o_size, // intermediate nodes size in bytes
          size_t itmd_cnt,
          size_t wg_size)
@@ -92,57 +336,13 @@ merklize(sycl::queue& q,
   // Note N = power of 2
   assert(leaf_cnt == itmd_cnt + 1);
 
-#if defined SHA1
-  assert(i_size == leaf_cnt * sha1::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha1::OUT_LEN_BYTES);
-#elif defined SHA2_224
-  assert(i_size == leaf_cnt * sha2_224::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha2_224::OUT_LEN_BYTES);
-#elif defined SHA2_256
-  assert(i_size == leaf_cnt * sha2_256::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha2_256::OUT_LEN_BYTES);
-#elif defined SHA2_384
-  assert(i_size == leaf_cnt * sha2_384::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha2_384::OUT_LEN_BYTES);
-#elif defined SHA2_512
-  assert(i_size == leaf_cnt * sha2_512::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha2_512::OUT_LEN_BYTES);
-#elif defined SHA2_512_224
-  assert(i_size == leaf_cnt * sha2_512_224::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * 32);
-#elif defined SHA2_512_256
-  assert(i_size == leaf_cnt * sha2_512_256::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha2_512_256::OUT_LEN_BYTES);
-#elif defined SHA3_256
-  assert(i_size == leaf_cnt * sha3_256::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha3_256::OUT_LEN_BYTES);
-#elif defined SHA3_224
-  assert(i_size == leaf_cnt * sha3_224::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha3_224::OUT_LEN_BYTES);
-#elif defined SHA3_384
-  assert(i_size == leaf_cnt * sha3_384::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha3_384::OUT_LEN_BYTES);
-#elif defined SHA3_512
-  assert(i_size == leaf_cnt * sha3_512::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * sha3_512::OUT_LEN_BYTES);
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-  assert(i_size == leaf_cnt * keccak_256::OUT_LEN_BYTES);
-  assert(o_size == (itmd_cnt + 1) * keccak_256::OUT_LEN_BYTES);
-#endif
-
-  // both input and output allocation has same size
-#if defined SHA1 || defined SHA2_224 || defined SHA2_256 ||                    \
-  defined SHA2_384 || defined SHA2_512 || defined SHA2_512_256 ||              \
-  defined SHA3_256 || defined SHA3_224 || defined SHA3_384 ||                  \
-  defined SHA3_512 || defined KECCAK_256
-
-  assert(i_size == o_size);
-
-#elif defined SHA2_512_224
-
-  assert(i_size + (leaf_cnt << 2) == o_size);
-
-#endif
+  assert(i_size == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  // both input and output allocation has same size, except for SHA2-512/224,
+  // where each intermediate node is 4 -bytes wider than leaf node
+  assert(i_size + leaf_cnt * (H::NODE_LEN_BYTES - H::DIGEST_LEN_BYTES) ==
+         o_size);
 
   // only tree with power of 2 many leaf nodes
   // can be merklized by this implementation
@@ -159,146 +359,10 @@ merklize(sycl::queue& q,
   // active work-items
   assert(work_item_cnt % wg_size == 0);
 
-#if defined SHA1 || defined SHA2_224 || defined SHA2_256
-  // # -of 32 -bit unsigned integers, which can be contiguously placed
-  // on output memory allocation
-  //
-  // note that `o_size` is in terms of bytes
-  const size_t elm_cnt = o_size >> 2;
-#elif defined SHA2_384 || defined SHA2_512 || defined SHA2_512_224 ||          \
-  defined SHA2_512_256
-  // # -of 64 -bit unsigned integers, which can be contiguously placed
-  // on output memory allocation
-  //
-  // note that `o_size` is in terms of bytes
-  const size_t elm_cnt = o_size >> 3;
-#elif defined SHA3_256 || defined SHA3_224 || defined SHA3_384 ||              \
-  defined SHA3_512 || defined KECCAK_256_U64 || defined KECCAK_256_U32
-  // # -of 8 -bit unsigned integers ( read a byte ), which can be contiguously
-  // placed on output memory allocation
-  //
-  // note that `o_size` is in terms of bytes
-  const size_t elm_cnt = o_size;
-#endif
-
-  constexpr size_t i_offset = 0;
-  const size_t o_offset = elm_cnt >> 1;
-
   // computes all intermediate nodes which are living just above leaf nodes of
   // binary merkle tree
-  sycl::event evt_0 = q.submit([&](sycl::handler& h) {
-    h.parallel_for<class kernelBinaryMerklizationPhase0>(
-      sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
-                         sycl::range<1>{ wg_size } },
-      [=](sycl::nd_item<1> it) {
-        const size_t idx = it.get_global_linear_id();
-
-#if defined SHA1
-        const size_t in_idx = idx * (sha1::IN_LEN_BYTES >> 2);
-        const size_t out_idx = idx * (sha1::OUT_LEN_BYTES >> 2);
-
-        sycl::uint padded[16];
-#elif defined SHA2_224
-        const size_t in_idx = idx * (sha2_224::IN_LEN_BYTES >> 2);
-        const size_t out_idx = idx * (sha2_224::OUT_LEN_BYTES >> 2);
-
-        sycl::uint padded[32];
-#elif defined SHA2_256
-        const size_t in_idx = idx * (sha2_256::IN_LEN_BYTES >> 2);
-        const size_t out_idx = idx * (sha2_256::OUT_LEN_BYTES >> 2);
-
-        sycl::uint padded[32];
-#elif defined SHA2_384
-        const size_t in_idx = idx * (sha2_384::IN_LEN_BYTES >> 3);
-        const size_t out_idx = idx * (sha2_384::OUT_LEN_BYTES >> 3);
-
-        sycl::ulong padded[16];
-#elif defined SHA2_512
-        const size_t in_idx = idx * (sha2_512::IN_LEN_BYTES >> 3);
-        const size_t out_idx = idx * (sha2_512::OUT_LEN_BYTES >> 3);
-
-        sycl::ulong padded[32];
-#elif defined SHA2_512_224
-        const size_t in_idx = idx * (sha2_512_224::IN_LEN_BYTES >> 3);
-        const size_t out_idx = idx * (32 >> 3);
-
-        sycl::ulong padded[16];
-#elif defined SHA2_512_256
-        const size_t in_idx = idx * (sha2_512_256::IN_LEN_BYTES >> 3);
-        const size_t out_idx = idx * (sha2_512_256::OUT_LEN_BYTES >> 3);
-
-        sycl::ulong padded[16];
-#elif defined SHA3_256
-        const size_t in_idx = idx * sha3_256::IN_LEN_BYTES;
-        const size_t out_idx = idx * sha3_256::OUT_LEN_BYTES;
-#elif defined SHA3_224
-        const size_t in_idx = idx * sha3_224::IN_LEN_BYTES;
-        const size_t out_idx = idx * sha3_224::OUT_LEN_BYTES;
-#elif defined SHA3_384
-        const size_t in_idx = idx * sha3_384::IN_LEN_BYTES;
-        const size_t out_idx = idx * sha3_384::OUT_LEN_BYTES;
-#elif defined SHA3_512
-        const size_t in_idx = idx * sha3_512::IN_LEN_BYTES;
-        const size_t out_idx = idx * sha3_512::OUT_LEN_BYTES;
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-        const size_t in_idx = idx * keccak_256::IN_LEN_BYTES;
-        const size_t out_idx = idx * keccak_256::OUT_LEN_BYTES;
-#endif
-
-#if defined SHA1
-        sha1::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha1::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA2_224
-        sha2_224::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha2_224::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA2_256
-        sha2_256::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha2_256::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA2_384
-        sha2_384::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha2_384::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA2_512
-        sha2_512::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha2_512::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA2_512_224
-        sha2_512_224::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha2_512_224::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA2_512_256
-        sha2_512_256::pad_input_message(leaf_nodes + i_offset + in_idx, padded);
-        sha2_512_256::hash(padded, intermediates + o_offset + out_idx);
-#elif defined SHA3_256
-        const sycl::uchar* in = leaf_nodes + i_offset + in_idx;
-        sycl::uchar* out = intermediates + o_offset + out_idx;
-
-        sha3_256::hash(in, out);
-#elif defined SHA3_224
-        const sycl::uchar* in = leaf_nodes + i_offset + in_idx;
-        sycl::uchar* out = intermediates + o_offset + out_idx;
-
-        sha3_224::hash(in, out);
-#elif defined SHA3_384
-        const sycl::uchar* in = leaf_nodes + i_offset + in_idx;
-        sycl::uchar* out = intermediates + o_offset + out_idx;
-
-        sha3_384::hash(in, out);
-#elif defined SHA3_512
-        const sycl::uchar* in = leaf_nodes + i_offset + in_idx;
-        sycl::uchar* out = intermediates + o_offset + out_idx;
-
-        sha3_512::hash(in, out);
-#elif defined KECCAK_256_U64
-        const sycl::uchar* in = leaf_nodes + i_offset + in_idx;
-        sycl::uchar* out = intermediates + o_offset + out_idx;
-
-        keccak_256::hash(in, out);
-#elif defined KECCAK_256_U32
-        const sycl::uchar* in = leaf_nodes + i_offset + in_idx;
-        sycl::uchar* out = intermediates + o_offset + out_idx;
-
-        keccak_256::hash_u32(in, out);
-#endif
-      });
-  });
+  sycl::event evt_0 = merklize_phase0<H>(
+    q, leaf_nodes, leaf_cnt, intermediates, 0, work_item_cnt, wg_size, {});
 
   // these many kernel dispatch rounds still remaining
   const size_t rounds =
@@ -314,182 +378,7 @@ merklize(sycl::queue& q,
   // nodes living immediately above them
   evts_0.push_back(evt_0);
 
-  for (size_t r = 0; r < rounds; r++) {
-    // multiple rounds of kernel dispatches, where intermediate nodes are being
-    // computed from already computed (in previous dispatch round) intermediate
-    // nodes
-    sycl::event evt_1 = q.submit([&](sycl::handler& h) {
-      // note, dependency chain being built !
-      //
-      // each dispatch round depends on previously enqueued dispatch round
-      h.depends_on(evts_0.at(r));
-
-      const size_t work_item_cnt_ = work_item_cnt >> (r + 1);
-      const size_t wg_size_ =
-        wg_size <= work_item_cnt_ ? wg_size : work_item_cnt_;
-
-      const size_t i_offset_ = o_offset >> r;
-      const size_t o_offset_ = i_offset_ >> 1;
-
-      h.parallel_for<class kernelBinaryMerklizationPhase1>(
-        sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt_ },
-                           sycl::range<1>{ wg_size_ } },
-        [=](sycl::nd_item<1> it) {
-          const size_t idx = it.get_global_linear_id();
-
-#if defined SHA1
-          const size_t in_idx = idx * (sha1::IN_LEN_BYTES >> 2);
-          const size_t out_idx = idx * (sha1::OUT_LEN_BYTES >> 2);
-
-          sycl::uint padded[16];
-#elif defined SHA2_224
-          const size_t in_idx = idx * (sha2_224::IN_LEN_BYTES >> 2);
-          const size_t out_idx = idx * (sha2_224::OUT_LEN_BYTES >> 2);
-
-          sycl::uint padded[32];
-#elif defined SHA2_256
-          const size_t in_idx = idx * (sha2_256::IN_LEN_BYTES >> 2);
-          const size_t out_idx = idx * (sha2_256::OUT_LEN_BYTES >> 2);
-
-          sycl::uint padded[32];
-#elif defined SHA2_384
-          const size_t in_idx = idx * (sha2_384::IN_LEN_BYTES >> 3);
-          const size_t out_idx = idx * (sha2_384::OUT_LEN_BYTES >> 3);
-
-          sycl::ulong padded[16];
-#elif defined SHA2_512
-          const size_t in_idx = idx * (sha2_512::IN_LEN_BYTES >> 3);
-          const size_t out_idx = idx * (sha2_512::OUT_LEN_BYTES >> 3);
-
-          sycl::ulong padded[32];
-#elif defined SHA2_512_224
-          const size_t in_idx = idx * (64 >> 3);
-          const size_t out_idx = idx * (32 >> 3);
-
-          // in following section, I'm extracting first 28 -bytes
-          // from two consecutive 32 -bytes SHA2-512/224 digests and
-          // concatenating them in 64 -bit word form such that total seven 64
-          // -bit words are holding total 56 -bytes (non-padded) input to 2-to-1
-          // SHA2-512/224 hash function
-          //
-          // so from eight 64 -bit words I'll prepare seven 64 -bit words
-          // which will be 2-to-1 hashed using SHA2-512/224 ( for binary
-          // merklization )
-          //
-          // that means first digest is leaf child and second one is right child
-          // of some parent node whose hash is being computed by this work-item
-          sycl::ulong in_words[7];
-
-          // pointer aliasing for ease of typing ( and understanding )
-          sycl::ulong* in_ptr = intermediates + i_offset_ + in_idx;
-
-          // first three 64 -bit words of first SHA2-512/224 digest
-          // are taken as they are
-          in_words[0] = *(in_ptr + 0);
-          in_words[1] = *(in_ptr + 1);
-          in_words[2] = *(in_ptr + 2);
-          // then  MSB 32 -bits of last word of first digest
-          // and MSB 32 -bits of first word of second digest are
-          // concatenated into single 64 -bit word
-          in_words[3] = (((*(in_ptr + 3) >> 32) & 0xfffffffful) << 32) |
-                        ((*(in_ptr + 4) >> 32) & 0xfffffffful);
-
-          // then next consecutive 192 -bits are taken such that
-          // it can be stored in three consecutive 64 -bit words
-          in_words[4] = ((*(in_ptr + 4) & 0xfffffffful) << 32) |
-                        ((*(in_ptr + 5) >> 32) & 0xfffffffful);
-
-          in_words[5] = ((*(in_ptr + 5) & 0xfffffffful) << 32) |
-                        ((*(in_ptr + 6) >> 32) & 0xfffffffful);
-
-          in_words[6] = ((*(in_ptr + 6) & 0xfffffffful) << 32) |
-                        ((*(in_ptr + 7) >> 32) & 0xfffffffful);
-
-          sycl::ulong padded[16];
-
-#elif defined SHA2_512_256
-          const size_t in_idx = idx * (sha2_512_256::IN_LEN_BYTES >> 3);
-          const size_t out_idx = idx * (sha2_512_256::OUT_LEN_BYTES >> 3);
-
-          sycl::ulong padded[16];
-#elif defined SHA3_256
-          const size_t in_idx = idx * sha3_256::IN_LEN_BYTES;
-          const size_t out_idx = idx * sha3_256::OUT_LEN_BYTES;
-#elif defined SHA3_224
-          const size_t in_idx = idx * sha3_224::IN_LEN_BYTES;
-          const size_t out_idx = idx * sha3_224::OUT_LEN_BYTES;
-#elif defined SHA3_384
-          const size_t in_idx = idx * sha3_384::IN_LEN_BYTES;
-          const size_t out_idx = idx * sha3_384::OUT_LEN_BYTES;
-#elif defined SHA3_512
-          const size_t in_idx = idx * sha3_512::IN_LEN_BYTES;
-          const size_t out_idx = idx * sha3_512::OUT_LEN_BYTES;
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-          const size_t in_idx = idx * keccak_256::IN_LEN_BYTES;
-          const size_t out_idx = idx * keccak_256::OUT_LEN_BYTES;
-#endif
-
-#if defined SHA1
-          sha1::pad_input_message(intermediates + i_offset_ + in_idx, padded);
-          sha1::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA2_224
-          sha2_224::pad_input_message(intermediates + i_offset_ + in_idx,
-                                      padded);
-          sha2_224::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA2_256
-          sha2_256::pad_input_message(intermediates + i_offset_ + in_idx,
-                                      padded);
-          sha2_256::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA2_384
-          sha2_384::pad_input_message(intermediates + i_offset_ + in_idx,
-                                      padded);
-          sha2_384::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA2_512
-          sha2_512::pad_input_message(intermediates + i_offset_ + in_idx,
-                                      padded);
-          sha2_512::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA2_512_224
-          sha2_512_224::pad_input_message(in_words, padded);
-          sha2_512_224::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA2_512_256
-          sha2_512_256::pad_input_message(intermediates + i_offset_ + in_idx,
-                                          padded);
-          sha2_512_256::hash(padded, intermediates + o_offset_ + out_idx);
-#elif defined SHA3_256
-          const sycl::uchar* in = intermediates + i_offset_ + in_idx;
-          sycl::uchar* out = intermediates + o_offset_ + out_idx;
-
-          sha3_256::hash(in, out);
-#elif defined SHA3_224
-          const sycl::uchar* in = intermediates + i_offset_ + in_idx;
-          sycl::uchar* out = intermediates + o_offset_ + out_idx;
-
-          sha3_224::hash(in, out);
-#elif defined SHA3_384
-          const sycl::uchar* in = intermediates + i_offset_ + in_idx;
-          sycl::uchar* out = intermediates + o_offset_ + out_idx;
-
-          sha3_384::hash(in, out);
-#elif defined SHA3_512
-          const sycl::uchar* in = intermediates + i_offset_ + in_idx;
-          sycl::uchar* out = intermediates + o_offset_ + out_idx;
-
-          sha3_512::hash(in, out);
-#elif defined KECCAK_256_U64
-          const sycl::uchar* in = intermediates + i_offset_ + in_idx;
-          sycl::uchar* out = intermediates + o_offset_ + out_idx;
-
-          keccak_256::hash(in, out);
-#elif defined KECCAK_256_U32
-          const sycl::uchar* in = intermediates + i_offset_ + in_idx;
-          sycl::uchar* out = intermediates + o_offset_ + out_idx;
-
-          keccak_256::hash_u32(in, out);
-#endif
-        });
-    });
-    evts_0.push_back(evt_1);
-  }
+  merklize_phase1<H>(q, leaf_cnt, intermediates, wg_size, &evts_0);
 
   // wait for last kernel dispatch round, where root of binary merkle tree is
   // computed !
@@ -504,3 +393,35 @@ merklize(sycl::queue& q,
   // return total kernel execution cost, in terms of nanosecond
   return ts;
 }
+
+// Binary merklization, where SHA variant to be used as 2-to-1 hash function is
+// chosen at run-time, using `v`; it's dispatched to one of fully specialized
+// instances of above routine, once per call
+//
+// Leaf nodes & intermediate nodes must be represented using word type of
+// chosen SHA variant ( see `word_t` of hasher policies in hasher.hpp )
+sycl::cl_ulong
+merklize(sycl::queue& q,
+         hasher::variant v,
+         const void* __restrict leaf_nodes,
+         size_t i_size, // leaf nodes size in bytes
+         size_t leaf_cnt,
+         void* const __restrict intermediates,
+         size_t o_size, // intermediate nodes size in bytes
+         size_t itmd_cnt,
+         size_t wg_size)
+{
+  return hasher::dispatch(v, [&](auto h) {
+    using H = decltype(h);
+    using word_t = typename H::word_t;
+
+    return merklize<H>(q,
+                       static_cast<const word_t*>(leaf_nodes),
+                       i_size,
+                       leaf_cnt,
+                       static_cast<word_t*>(intermediates),
+                       o_size,
+                       itmd_cnt,
+                       wg_size);
+  });
+}
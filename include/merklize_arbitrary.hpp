@@ -0,0 +1,244 @@
+#pragma once
+#include "merklize.hpp"
+#include <vector>
+
+// What to do with last node of some level of binary merkle tree, when that
+// level has odd number of nodes, so last node doesn't have any sibling
+enum class odd_node_policy
+{
+  // last node is moved to level just above, unchanged
+  promote,
+  // last node is 2-to-1 hashed with itself, as done in Bitcoin
+  duplicate,
+  // leaf nodes are split at largest power of 2 lesser than leaf count, as
+  // defined in https://www.rfc-editor.org/rfc/rfc6962#section-2.1, which
+  // results into exactly same nodes as `promote` does, when computed bottom-up
+  //
+  // Note, RFC 6962 style domain separation of leaf & intermediate nodes is not
+  // applied, as leaf nodes are already hash digests
+  rfc6962,
+};
+
+// # -of nodes living on level `lvl` of binary merkle tree with `leaf_cnt`
+// -many leaf nodes, where leaf nodes live at level 0
+//
+// Note, # -of nodes on each level doesn't depend on odd node policy
+inline size_t
+level_node_cnt(size_t leaf_cnt, size_t lvl)
+{
+  size_t cnt = leaf_cnt;
+  for (size_t l = 0; l < lvl; l++) {
+    cnt = (cnt + 1) >> 1;
+  }
+  return cnt;
+}
+
+// # -of levels of intermediate nodes ( including root ) of binary merkle tree
+// with `leaf_cnt` -many leaf nodes
+inline size_t
+level_cnt(size_t leaf_cnt)
+{
+  size_t lvl = 0;
+  for (size_t cnt = leaf_cnt; cnt > 1; cnt = (cnt + 1) >> 1) {
+    lvl++;
+  }
+  return lvl;
+}
+
+// Offset ( in terms of nodes ) of first intermediate node of each level of
+// binary merkle tree with `leaf_cnt` -many leaf nodes, on output memory
+// allocation, where returned vector is indexed by level
+//
+// Just like `merklize` does, first node of output memory allocation is never
+// used, root of tree lives at node index 1, then immediately followed by all
+// nodes of level just below root and so on, until level 1 ( just above leaf
+// nodes ) is reached; which means
+//
+// offset[lvl_cnt] = 1
+// offset[lvl] = offset[lvl + 1] + level_node_cnt(leaf_cnt, lvl + 1)
+//
+// where offset[0] is set to 0, because leaf nodes don't live on output memory
+// allocation
+//
+// When leaf count is power of 2, offset[lvl] = leaf_cnt >> lvl, which is
+// exactly same layout as `merklize` produces
+inline std::vector<size_t>
+level_offsets(size_t leaf_cnt)
+{
+  const size_t lvl_cnt = level_cnt(leaf_cnt);
+  std::vector<size_t> offsets(lvl_cnt + 1, 0);
+
+  if (lvl_cnt > 0) {
+    offsets[lvl_cnt] = 1;
+  }
+  for (size_t l = lvl_cnt; l > 1; l--) {
+    offsets[l - 1] = offsets[l] + level_node_cnt(leaf_cnt, l);
+  }
+
+  return offsets;
+}
+
+// # -of intermediate nodes ( including root ) of binary merkle tree with
+// `leaf_cnt` -many leaf nodes, which is (leaf_cnt - 1) when leaf count is power
+// of 2
+inline size_t
+intermediate_cnt(size_t leaf_cnt)
+{
+  const size_t lvl_cnt = level_cnt(leaf_cnt);
+  if (lvl_cnt == 0) {
+    return 0;
+  }
+
+  return level_offsets(leaf_cnt)[1] + level_node_cnt(leaf_cnt, 1) - 1;
+}
+
+// Computes an intermediate node by 2-to-1 hashing single intermediate node (
+// = NODE_WORDS -many words ) with itself, while digest is written to NODE_WORDS
+// -many words of output memory
+template<typename H>
+inline void
+hash_node_twice(const typename H::word_t* __restrict in,
+                typename H::word_t* const __restrict out)
+{
+  using word_t = typename H::word_t;
+
+  word_t in_words[H::NODE_WORDS << 1];
+
+#pragma unroll 8
+  for (size_t i = 0; i < H::NODE_WORDS; i++) {
+    in_words[i] = in[i];
+    in_words[H::NODE_WORDS + i] = in[i];
+  }
+
+  node::hash_nodes<H>(in_words, out);
+}
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationArbitrary;
+
+// Binary merklization of arbitrary number ( >= 2 ) of leaf nodes, dispatching
+// one kernel per level, where last node of any level having odd number of
+// nodes is handled as `policy` says
+//
+// Leaf nodes are expected to be provided as ceil(leaf_cnt / 2) -many pairs of
+// consecutive leaf nodes, where each pair is LEAF_PAIR_WORDS -many words wide;
+// when leaf count is odd, last pair only holds one leaf node in its first half,
+// while rest of that pair is never read
+//
+// Intermediate nodes are placed on output memory allocation, following level
+// offset table, computed using `level_offsets`, while output memory allocation
+// must be able to hold (intermediate_cnt(leaf_cnt) + 1) -many intermediate
+// nodes
+//
+// When leaf count is power of 2, output is exactly same as `merklize` produces,
+// irrespective of odd node policy
+template<typename H>
+sycl::cl_ulong
+merklize_arbitrary(sycl::queue& q,
+                   const typename H::word_t* __restrict leaf_nodes,
+                   size_t i_size, // leaf nodes size in bytes
+                   size_t leaf_cnt,
+                   typename H::word_t* const __restrict intermediates,
+                   size_t o_size, // intermediate nodes size in bytes
+                   size_t itmd_cnt,
+                   size_t wg_size,
+                   odd_node_policy policy)
+{
+  using word_t = typename H::word_t;
+
+  assert(leaf_cnt >= 2);
+  assert(itmd_cnt == intermediate_cnt(leaf_cnt));
+
+  assert(i_size ==
+         ((leaf_cnt + 1) >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t));
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  // these many levels of intermediate nodes to be computed
+  const size_t lvl_cnt = level_cnt(leaf_cnt);
+  const std::vector<size_t> offsets = level_offsets(leaf_cnt);
+
+  const bool duplicate = policy == odd_node_policy::duplicate;
+
+  std::vector<sycl::event> evts;
+  evts.reserve(lvl_cnt);
+
+  for (size_t lvl = 1; lvl <= lvl_cnt; lvl++) {
+    // # -of nodes living on level being computed & level just below it
+    const size_t node_cnt = level_node_cnt(leaf_cnt, lvl);
+    const size_t child_cnt = level_node_cnt(leaf_cnt, lvl - 1);
+
+    const size_t o_offset = offsets[lvl];
+    const size_t i_offset = offsets[lvl - 1];
+    const bool from_leaves = lvl == 1;
+
+    // global range is rounded up to multiple of work-group size, while
+    // surplus work-items don't do anything
+    const size_t wg_size_ = wg_size <= node_cnt ? wg_size : node_cnt;
+    const size_t work_item_cnt =
+      ((node_cnt + wg_size_ - 1) / wg_size_) * wg_size_;
+
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      // each level depends on previous level being computed
+      if (!evts.empty()) {
+        h.depends_on(evts.back());
+      }
+
+      h.parallel_for<kernelBinaryMerklizationArbitrary<H>>(
+        sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                           sycl::range<1>{ wg_size_ } },
+        [=](sycl::nd_item<1> it) {
+          const size_t idx = it.get_global_linear_id();
+          if (idx >= node_cnt) {
+            return;
+          }
+
+          word_t* const out = intermediates + (o_offset + idx) * H::NODE_WORDS;
+          // does this node have two children ?
+          const bool paired = (idx << 1) + 1 < child_cnt;
+
+          if (from_leaves) {
+            const word_t* in = leaf_nodes + idx * H::LEAF_PAIR_WORDS;
+
+            if (paired) {
+              node::hash_leaves<H>(in, out);
+            } else if (duplicate) {
+              word_t in_words[H::NODE_WORDS];
+
+              node::leaf_to_node<H>(in, in_words);
+              hash_node_twice<H>(in_words, out);
+            } else {
+              node::leaf_to_node<H>(in, out);
+            }
+          } else {
+            const word_t* in =
+              intermediates + (i_offset + (idx << 1)) * H::NODE_WORDS;
+
+            if (paired) {
+              node::hash_nodes<H>(in, out);
+            } else if (duplicate) {
+              hash_node_twice<H>(in, out);
+            } else {
+#pragma unroll 8
+              for (size_t i = 0; i < H::NODE_WORDS; i++) {
+                out[i] = in[i];
+              }
+            }
+          }
+        });
+    });
+    evts.push_back(evt);
+  }
+
+  // wait for last kernel dispatch, where root of tree is computed
+  evts.back().wait();
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
@@ -0,0 +1,430 @@
+#pragma once
+#include "merklize.hpp"
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// # -of entries in per level work-group size table, where entry `k` is for
+// level having 2 ^ k -many nodes
+constexpr size_t TUNED_LVL_CNT = 64;
+
+// Work-group size used for levels which are not tuned yet, same as what
+// benchmarks use, unless level is narrower than that
+constexpr size_t DEFAULT_WG_SIZE = 1 << 5;
+
+// Tuned settings of one hasher policy, on one device
+struct tuned_config
+{
+  // implementation variant, computing same hash function, which should be used
+  // in place of this one ( see `alternatives` )
+  hasher::variant preferred;
+  // work-group size for level having 2 ^ k -many nodes, where 0 means level of
+  // that width was not tuned
+  size_t wg_sizes[TUNED_LVL_CNT];
+};
+
+// Implementation variants computing same hash function as `v`, including
+// itself, which produce same leaf/ intermediate node memory layout, so that
+// any of them can be used in place of `v`
+inline std::vector<hasher::variant>
+alternatives(hasher::variant v)
+{
+  if (v == hasher::variant::keccak_256_u64 ||
+      v == hasher::variant::keccak_256_u32) {
+    return { hasher::variant::keccak_256_u64, hasher::variant::keccak_256_u32 };
+  }
+
+  return { v };
+}
+
+// Fills work-group size of each level of binary merkle tree into
+// `lvl_wg_sizes` ( TUNED_LVL_CNT -many entries ), using `wg_sizes` of tuned
+// settings, where levels which were not tuned reuse work-group size of widest
+// tuned level narrower than them, falling back to DEFAULT_WG_SIZE, while none
+// of them is ever wider than its level
+inline void
+resolve_wg_sizes(const size_t* const wg_sizes, size_t* const lvl_wg_sizes)
+{
+  size_t last = DEFAULT_WG_SIZE;
+
+  for (size_t k = 0; k < TUNED_LVL_CNT; k++) {
+    if (wg_sizes[k] != 0) {
+      last = wg_sizes[k];
+    }
+    lvl_wg_sizes[k] = std::min(last, 1ul << k);
+  }
+}
+
+// Binary merklization, producing same output as `merklize`, where level having
+// 2 ^ k -many nodes is dispatched with work-group size `lvl_wg_sizes[k]` (
+// power of 2, <= 2 ^ k ), instead of one work-group size for all levels
+//
+// When `lvl_ts` is non-null, execution time of kernel computing level having
+// 2 ^ k -many nodes is written to `lvl_ts[k]`, for all levels of tree, while
+// total kernel execution time is returned, all in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_tuned(sycl::queue& q,
+               const typename H::word_t* __restrict leaf_nodes,
+               size_t i_size, // leaf nodes size in bytes
+               size_t leaf_cnt,
+               typename H::word_t* const __restrict intermediates,
+               size_t o_size, // intermediate nodes size in bytes
+               size_t itmd_cnt,
+               const size_t* const lvl_wg_sizes,
+               sycl::cl_ulong* const lvl_ts = nullptr)
+{
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt == itmd_cnt + 1);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(i_size == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  const size_t pair_cnt = leaf_cnt >> 1;
+  const size_t lvl =
+    static_cast<size_t>(sycl::log2(static_cast<double>(pair_cnt)));
+
+  std::vector<sycl::event> evts;
+  evts.reserve(lvl + 1);
+
+  evts.push_back(merklize_phase0<H>(q,
+                                    leaf_nodes,
+                                    leaf_cnt,
+                                    intermediates,
+                                    0,
+                                    pair_cnt,
+                                    lvl_wg_sizes[lvl],
+                                    {}));
+  merklize_phase1<H>(q, leaf_cnt, intermediates, lvl_wg_sizes, &evts);
+
+  // wait for last kernel dispatch round, where root of binary merkle tree is
+  // computed !
+  evts.back().wait();
+
+  // dispatch round `r` computes level having 2 ^ (lvl - r) -many nodes
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r <= lvl; r++) {
+    const sycl::cl_ulong ts_ = time_event(evts.at(r));
+
+    ts += ts_;
+    if (lvl_ts != nullptr) {
+      lvl_ts[lvl - r] = ts_;
+    }
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
+
+// Largest work-group size, which both kernels used for merklizing with hasher
+// policy `H` can be dispatched with, on device targeted by `q`, which may be
+// lower than maximum work-group size of device, for register heavy variants (
+// say SHA2-512, which compresses two message blocks per 2-to-1 hash )
+template<typename H>
+size_t
+max_merklize_wg_size(sycl::queue& q)
+{
+  const sycl::device d = q.get_device();
+  const std::vector<sycl::kernel_id> ids = {
+    sycl::get_kernel_id<kernelBinaryMerklizationPhase0<H>>(),
+    sycl::get_kernel_id<kernelBinaryMerklizationPhase1<H>>()
+  };
+  const auto bundle = sycl::get_kernel_bundle<sycl::bundle_state::executable>(
+    q.get_context(), { d }, ids);
+
+  size_t wg_size = d.get_info<sycl::info::device::max_work_group_size>();
+  for (const sycl::kernel_id& id : ids) {
+    const sycl::kernel k = bundle.get_kernel(id);
+    wg_size = std::min(
+      wg_size,
+      static_cast<size_t>(
+        k.get_info<sycl::info::kernel_device_specific::work_group_size>(d)));
+  }
+
+  return wg_size;
+}
+
+// Sweeps power of 2 work-group sizes ( upto `max_merklize_wg_size` ),
+// merklizing leaf nodes of tree having `leaf_cnt` -many leaf nodes,
+// `itr_cnt` times with each of them, while keeping fastest work-group size for
+// each level width separately, in `wg_sizes` ( TUNED_LVL_CNT -many entries,
+// where entries of levels wider than ones of this tree are set to 0 )
+//
+// Returns sum of fastest kernel execution time of all levels, in nanoseconds,
+// which is what merklization using tuned work-group sizes should cost
+template<typename H>
+sycl::cl_ulong
+tune_wg_sizes(sycl::queue& q,
+              size_t leaf_cnt,
+              size_t itr_cnt,
+              size_t* const wg_sizes)
+{
+  using word_t = typename H::word_t;
+
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(itr_cnt > 0);
+
+  const size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  const size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+  const size_t pair_cnt = leaf_cnt >> 1;
+  const size_t lvl =
+    static_cast<size_t>(sycl::log2(static_cast<double>(pair_cnt)));
+
+  const size_t max_wg_size = std::min(pair_cnt, max_merklize_wg_size<H>(q));
+
+  word_t* i_d = static_cast<word_t*>(sycl::malloc_device(i_size, q));
+  word_t* o_d = static_cast<word_t*>(sycl::malloc_device(o_size, q));
+
+  // leaf node bytes don't affect execution time of hash functions used here,
+  // as none of them have data dependent control flow
+  q.memset(i_d, 0xa5, i_size).wait();
+
+  std::vector<sycl::cl_ulong> best(
+    TUNED_LVL_CNT, std::numeric_limits<sycl::cl_ulong>::max());
+  std::vector<sycl::cl_ulong> lvl_ts(TUNED_LVL_CNT);
+  std::vector<sycl::cl_ulong> acc(TUNED_LVL_CNT);
+
+  for (size_t k = 0; k < TUNED_LVL_CNT; k++) {
+    wg_sizes[k] = 0;
+  }
+
+  for (size_t wg_size = 1; wg_size <= max_wg_size; wg_size <<= 1) {
+    size_t lvl_wg_sizes[TUNED_LVL_CNT];
+    for (size_t k = 0; k < TUNED_LVL_CNT; k++) {
+      lvl_wg_sizes[k] = std::min(wg_size, 1ul << k);
+    }
+
+    std::fill(acc.begin(), acc.end(), 0);
+
+    for (size_t i = 0; i < itr_cnt; i++) {
+      merklize_tuned<H>(q,
+                        i_d,
+                        i_size,
+                        leaf_cnt,
+                        o_d,
+                        o_size,
+                        leaf_cnt - 1,
+                        lvl_wg_sizes,
+                        lvl_ts.data());
+
+      for (size_t k = 0; k <= lvl; k++) {
+        acc[k] += lvl_ts[k];
+      }
+    }
+
+    // levels narrower than this work-group size were already measured with
+    // same work-group size, during earlier sweep
+    for (size_t k = 0; k <= lvl; k++) {
+      if ((1ul << k) >= wg_size && acc[k] < best[k]) {
+        best[k] = acc[k];
+        wg_sizes[k] = wg_size;
+      }
+    }
+  }
+
+  sycl::free(i_d, q);
+  sycl::free(o_d, q);
+
+  sycl::cl_ulong ts = 0;
+  for (size_t k = 0; k <= lvl; k++) {
+    ts += best[k] / itr_cnt;
+  }
+
+  return ts;
+}
+
+// Keeps tuned settings of hasher policies, on device targeted by `q`, while
+// persisting them to cache file at `path`, so that they're tuned only once per
+// device & hash function, while later runs pick them up automatically
+//
+// Each line of cache file holds settings of one hasher policy on one device,
+// as tab separated fields: device name, `ID` of hasher policy, `ID` of
+// preferred implementation variant & space separated TUNED_LVL_CNT -many
+// work-group sizes; lines of other devices are kept as they're found
+class autotuner
+{
+public:
+  autotuner(sycl::queue& q, const std::string& path)
+    : q(q)
+    , path(path)
+    , dev(q.get_device().get_info<sycl::info::device::name>())
+  {
+    load();
+  }
+
+  // Checks whether settings of `v` were tuned on this device
+  bool tuned(hasher::variant v) const
+  {
+    return cfgs.find(hasher::id(v)) != cfgs.end();
+  }
+
+  // Settings to be used with `v` on this device, which are defaults ( `v`
+  // itself, all levels untuned ) when it was never tuned
+  tuned_config config(hasher::variant v) const
+  {
+    auto it = cfgs.find(hasher::id(v));
+    if (it != cfgs.end()) {
+      return it->second;
+    }
+
+    tuned_config cfg;
+    cfg.preferred = v;
+    std::fill(cfg.wg_sizes, cfg.wg_sizes + TUNED_LVL_CNT, 0);
+    return cfg;
+  }
+
+  // Tunes work-group sizes of all implementation variants computing same hash
+  // function as `v` ( see `alternatives` ), on tree having `leaf_cnt` -many
+  // leaf nodes, choosing fastest of them as preferred variant, unless `v` was
+  // already tuned ( or `force` is set ), persisting results to cache file
+  //
+  // Returns false, when cache file couldn't be written
+  bool tune(hasher::variant v, size_t leaf_cnt, size_t itr_cnt, bool force)
+  {
+    if (tuned(v) && !force) {
+      return true;
+    }
+
+    const std::vector<hasher::variant> alts = alternatives(v);
+
+    std::vector<tuned_config> tuned_cfgs(alts.size());
+    sycl::cl_ulong best = std::numeric_limits<sycl::cl_ulong>::max();
+    hasher::variant preferred = v;
+
+    for (size_t i = 0; i < alts.size(); i++) {
+      const sycl::cl_ulong ts = hasher::dispatch(alts[i], [&](auto h) {
+        using H = decltype(h);
+        return tune_wg_sizes<H>(
+          q, leaf_cnt, itr_cnt, tuned_cfgs[i].wg_sizes);
+      });
+
+      if (ts < best) {
+        best = ts;
+        preferred = alts[i];
+      }
+    }
+
+    for (size_t i = 0; i < alts.size(); i++) {
+      tuned_cfgs[i].preferred = preferred;
+      cfgs[hasher::id(alts[i])] = tuned_cfgs[i];
+    }
+
+    return save();
+  }
+
+  // Binary merklization, same as `merklize` overload choosing SHA variant at
+  // run-time, where preferred implementation variant of `v` & tuned
+  // work-group sizes of each level are picked automatically, from settings
+  // tuned on this device ( or defaults, when `v` was never tuned )
+  sycl::cl_ulong merklize(hasher::variant v,
+                          const void* __restrict leaf_nodes,
+                          size_t i_size, // leaf nodes size in bytes
+                          size_t leaf_cnt,
+                          void* const __restrict intermediates,
+                          size_t o_size, // intermediate nodes size in bytes
+                          size_t itmd_cnt) const
+  {
+    const tuned_config cfg = config(v);
+    const tuned_config pref = config(cfg.preferred);
+
+    size_t lvl_wg_sizes[TUNED_LVL_CNT];
+    resolve_wg_sizes(pref.wg_sizes, lvl_wg_sizes);
+
+    return hasher::dispatch(cfg.preferred, [&](auto h) {
+      using H = decltype(h);
+      using word_t = typename H::word_t;
+
+      return merklize_tuned<H>(q,
+                               static_cast<const word_t*>(leaf_nodes),
+                               i_size,
+                               leaf_cnt,
+                               static_cast<word_t*>(intermediates),
+                               o_size,
+                               itmd_cnt,
+                               lvl_wg_sizes);
+    });
+  }
+
+private:
+  // Reads settings of this device from cache file, if it exists, while lines
+  // of other devices & malformed lines are kept aside/ skipped
+  void load()
+  {
+    std::ifstream f(path);
+    std::string line;
+
+    while (std::getline(f, line)) {
+      std::istringstream ss(line);
+      std::string dev_, id_, pref_id, wgs;
+
+      if (!std::getline(ss, dev_, '\t') || !std::getline(ss, id_, '\t') ||
+          !std::getline(ss, pref_id, '\t') || !std::getline(ss, wgs)) {
+        continue;
+      }
+
+      if (dev_ != dev) {
+        foreign.push_back(line);
+        continue;
+      }
+
+      hasher::variant v, pref;
+      if (!hasher::from_id(id_.c_str(), &v) ||
+          !hasher::from_id(pref_id.c_str(), &pref)) {
+        continue;
+      }
+
+      tuned_config cfg;
+      cfg.preferred = pref;
+
+      std::istringstream ws(wgs);
+      size_t k = 0;
+      for (; k < TUNED_LVL_CNT && (ws >> cfg.wg_sizes[k]); k++) {
+        // work-group size must be power of 2, as it must divide level width
+        if ((cfg.wg_sizes[k] & (cfg.wg_sizes[k] - 1)) != 0 ||
+            cfg.wg_sizes[k] > (1ul << k)) {
+          break;
+        }
+      }
+      if (k != TUNED_LVL_CNT) {
+        continue;
+      }
+
+      cfgs[hasher::id(v)] = cfg;
+    }
+  }
+
+  // Writes settings of all devices back to cache file, returning false when it
+  // couldn't be written
+  bool save() const
+  {
+    std::ofstream f(path, std::ios::trunc);
+
+    for (const std::string& line : foreign) {
+      f << line << '\n';
+    }
+
+    for (const auto& [id_, cfg] : cfgs) {
+      f << dev << '\t' << id_ << '\t' << hasher::id(cfg.preferred) << '\t';
+      for (size_t k = 0; k < TUNED_LVL_CNT; k++) {
+        f << cfg.wg_sizes[k] << (k + 1 < TUNED_LVL_CNT ? ' ' : '\n');
+      }
+    }
+
+    f.flush();
+    return static_cast<bool>(f);
+  }
+
+  sycl::queue& q;
+  const std::string path;
+  const std::string dev;
+
+  // settings of this device, keyed by `ID` of hasher policy
+  std::map<std::string, tuned_config> cfgs;
+  // lines of cache file, belonging to other devices
+  std::vector<std::string> foreign;
+};
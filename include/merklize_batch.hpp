@@ -0,0 +1,199 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <vector>
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationBatch;
+
+// Batched binary merklization of `tree_cnt` -many ( possibly differently sized
+// ) binary merkle trees, dispatching one kernel per tree level across whole
+// batch, instead of one kernel per tree level per tree
+//
+// Tree `t` has (leaf_offs[t + 1] - leaf_offs[t]) -many leaf nodes, which must
+// be power of 2 ( >= 2 ), while `leaf_offs` is host memory holding (tree_cnt +
+// 1) -many leaf offsets, where leaf_offs[0] = 0 and leaf_offs[tree_cnt] = total
+// # -of leaf nodes in batch
+//
+// Leaf nodes of all trees are placed one after another, on input memory
+// allocation, as pairs of consecutive leaf nodes ( LEAF_PAIR_WORDS -many words
+// each ), so leaf nodes of tree `t` begin at pair index (leaf_offs[t] / 2)
+//
+// Intermediate nodes of tree `t` occupy node index [leaf_offs[t],
+// leaf_offs[t + 1]) of output memory allocation, following same memory layout
+// as `merklize` produces for single tree, meaning root of tree `t` lives at
+// node index (leaf_offs[t] + 1), while node index leaf_offs[t] is never used
+//
+// When batch consists of many small trees, kernel dispatch cost is paid
+// log2(largest leaf count) -many times, instead of being paid that many times
+// for each tree
+template<typename H>
+sycl::cl_ulong
+merklize_batch(sycl::queue& q,
+               const typename H::word_t* __restrict leaf_nodes,
+               size_t i_size, // leaf nodes size in bytes
+               const size_t* const leaf_offs,
+               size_t tree_cnt,
+               typename H::word_t* const __restrict intermediates,
+               size_t o_size, // intermediate nodes size in bytes
+               size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  assert(tree_cnt > 0);
+  assert(leaf_offs[0] == 0);
+
+  // # -of levels of intermediate nodes in tallest tree of batch
+  size_t lvl_cnt = 0;
+  for (size_t t = 0; t < tree_cnt; t++) {
+    const size_t leaf_cnt = leaf_offs[t + 1] - leaf_offs[t];
+
+    // only trees with power of 2 many leaf nodes
+    // can be merklized by this implementation
+    assert(leaf_cnt >= 2);
+    assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+    const size_t lvl_cnt_ =
+      static_cast<size_t>(sycl::log2(static_cast<double>(leaf_cnt)));
+    lvl_cnt = std::max(lvl_cnt, lvl_cnt_);
+  }
+
+  const size_t total_leaf_cnt = leaf_offs[tree_cnt];
+
+  assert(i_size ==
+         (total_leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t));
+  assert(o_size == total_leaf_cnt * H::NODE_LEN_BYTES);
+
+  // For each level `l` ( >= 1 ) of intermediate nodes, a prefix table of
+  // (tree_cnt + 1) -many entries is prepared, where entry `t` holds # -of nodes
+  // living on level `l` of all trees before tree `t`; each work-item finds tree
+  // it works on, by binary searching in prefix table of level being computed
+  //
+  // All of these tables are placed one after another, followed by leaf offsets,
+  // so that they're copied to accelerator using single data transfer
+  const size_t tbl_len = tree_cnt + 1;
+  std::vector<size_t> tbls((lvl_cnt + 1) * tbl_len, 0);
+
+  for (size_t l = 0; l < lvl_cnt; l++) {
+    size_t* const prefix = tbls.data() + l * tbl_len;
+
+    for (size_t t = 0; t < tree_cnt; t++) {
+      const size_t leaf_cnt = leaf_offs[t + 1] - leaf_offs[t];
+      prefix[t + 1] = prefix[t] + (leaf_cnt >> (l + 1));
+    }
+  }
+  std::copy(leaf_offs, leaf_offs + tbl_len, tbls.begin() + lvl_cnt * tbl_len);
+
+  const size_t tbls_size = sizeof(size_t) * tbls.size();
+  size_t* tbls_d = static_cast<size_t*>(sycl::malloc_device(tbls_size, q));
+
+  sycl::event evt_0 = q.memcpy(tbls_d, tbls.data(), tbls_size);
+
+  std::vector<sycl::event> evts;
+  evts.reserve(lvl_cnt);
+
+  for (size_t l = 0; l < lvl_cnt; l++) {
+    // # -of nodes to be computed on this level, across whole batch
+    const size_t node_cnt = tbls[l * tbl_len + tree_cnt];
+
+    // global range is rounded up to multiple of work-group size, while
+    // surplus work-items don't do anything
+    const size_t wg_size_ = wg_size <= node_cnt ? wg_size : node_cnt;
+    const size_t work_item_cnt =
+      ((node_cnt + wg_size_ - 1) / wg_size_) * wg_size_;
+
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      // each level depends on previous level being computed
+      h.depends_on(evts.empty() ? evt_0 : evts.back());
+
+      const size_t* prefix = tbls_d + l * tbl_len;
+      const size_t* offs = tbls_d + lvl_cnt * tbl_len;
+      const bool from_leaves = l == 0;
+
+      h.parallel_for<kernelBinaryMerklizationBatch<H>>(
+        sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                           sycl::range<1>{ wg_size_ } },
+        [=](sycl::nd_item<1> it) {
+          const size_t idx = it.get_global_linear_id();
+          if (idx >= node_cnt) {
+            return;
+          }
+
+          // find last tree `t` such that prefix[t] <= idx, which is always
+          // one having at least one node on this level
+          size_t lo = 0;
+          size_t hi = tree_cnt - 1;
+          while (lo < hi) {
+            const size_t mid = (lo + hi + 1) >> 1;
+            if (prefix[mid] <= idx) {
+              lo = mid;
+            } else {
+              hi = mid - 1;
+            }
+          }
+
+          // level of tree `lo` being computed lives at node index [m, 2m) of
+          // that tree, when it has m -many nodes
+          const size_t m = prefix[lo + 1] - prefix[lo];
+          const size_t n_idx = m + idx - prefix[lo];
+
+          word_t* const out =
+            intermediates + (offs[lo] + n_idx) * H::NODE_WORDS;
+
+          if (from_leaves) {
+            const size_t p_idx = (offs[lo] >> 1) + idx - prefix[lo];
+            node::hash_leaves<H>(leaf_nodes + p_idx * H::LEAF_PAIR_WORDS, out);
+          } else {
+            node::hash_nodes<H>(
+              intermediates + (offs[lo] + (n_idx << 1)) * H::NODE_WORDS, out);
+          }
+        });
+    });
+    evts.push_back(evt);
+  }
+
+  // wait for last kernel dispatch, where roots of tallest trees are computed
+  evts.back().wait();
+
+  sycl::free(tbls_d, q);
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
+
+// Batched binary merklization of `tree_cnt` -many equal sized binary merkle
+// trees, each having `leaf_cnt` -many leaf nodes ( power of 2 ), placed one
+// after another on input/ output memory allocation; see above routine for
+// memory layout
+template<typename H>
+sycl::cl_ulong
+merklize_batch(sycl::queue& q,
+               const typename H::word_t* __restrict leaf_nodes,
+               size_t i_size, // leaf nodes size in bytes
+               size_t leaf_cnt,
+               size_t tree_cnt,
+               typename H::word_t* const __restrict intermediates,
+               size_t o_size, // intermediate nodes size in bytes
+               size_t wg_size)
+{
+  std::vector<size_t> leaf_offs(tree_cnt + 1);
+  for (size_t t = 0; t <= tree_cnt; t++) {
+    leaf_offs[t] = t * leaf_cnt;
+  }
+
+  return merklize_batch<H>(q,
+                           leaf_nodes,
+                           i_size,
+                           leaf_offs.data(),
+                           tree_cnt,
+                           intermediates,
+                           o_size,
+                           wg_size);
+}
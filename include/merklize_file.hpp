@@ -0,0 +1,276 @@
+#pragma once
+#include "merklize_stream.hpp"
+#include "merklize_zero_copy.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of flat file, holding leaf nodes as pairs of
+// consecutive leaf nodes, one after another, exactly as `merklize` expects them
+// on input memory allocation, so that file contents can be merklized without
+// first reading them into a separate host buffer
+//
+// Kernel is asked to read mapping ahead aggressively ( MADV_SEQUENTIAL ), as
+// leaf nodes are consumed from beginning to end, while huge pages are asked for
+// ( MADV_HUGEPAGE ), when available, so that fewer page faults & TLB misses
+// are incurred on mapping of tens of GB; both of them are only hints
+//
+// Whether file could be mapped, is checked using `valid()`
+class leaf_file
+{
+public:
+  explicit leaf_file(const char* path)
+    : fd(-1)
+    , ptr(nullptr)
+    , len(0)
+  {
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+      return;
+    }
+
+    const size_t len_ = static_cast<size_t>(st.st_size);
+
+    void* ptr_ = mmap(nullptr, len_, PROT_READ, MAP_SHARED, fd, 0);
+    if (ptr_ == MAP_FAILED) {
+      return;
+    }
+
+    ptr = ptr_;
+    len = len_;
+
+    madvise(ptr, len, MADV_SEQUENTIAL);
+#if defined(MADV_HUGEPAGE)
+    madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+  }
+
+  leaf_file(const leaf_file&) = delete;
+  leaf_file& operator=(const leaf_file&) = delete;
+
+  ~leaf_file()
+  {
+    if (ptr != nullptr) {
+      munmap(ptr, len);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  bool valid() const { return ptr != nullptr; }
+
+  // Beginning of mapping, reinterpreted as words of chosen hasher policy
+  template<typename H>
+  const typename H::word_t* leaf_nodes() const
+  {
+    return static_cast<const typename H::word_t*>(ptr);
+  }
+
+  // Size of file, in bytes
+  size_t size() const { return len; }
+
+private:
+  int fd;
+  void* ptr;
+  size_t len;
+};
+
+// Binary merklization of `leaf_cnt` -many ( power of 2 ) leaf nodes, living on
+// memory mapped file `f`, which must be of `leaf_cnt * DIGEST_LEN_BYTES` bytes,
+// where leaf nodes are copied from mapping to accelerator memory, chunk by
+// chunk, through two staging buffers of `chunk_leaf_cnt` -many ( power of 2 )
+// leaf nodes each, used in round-robin fashion, so that whole file is never
+// duplicated on accelerator memory; first phase of `merklize` is dispatched on
+// each chunk as soon as it lands, while transfer of next chunk is already
+// enqueued
+//
+// When `chunk_leaf_cnt` is 0, it's chosen using `stream_chunk_leaf_cnt`, based
+// on global memory size of device, while it's never larger than `leaf_cnt`
+//
+// Intermediate nodes are written to `intermediates`, living on accelerator
+// memory, in exactly same layout as `merklize` produces
+//
+// Host to device data transfer time is written to `tx_ts[0]`, while total
+// kernel execution time is returned, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_file_staged(sycl::queue& q,
+                     const leaf_file& f,
+                     size_t leaf_cnt,
+                     typename H::word_t* const __restrict intermediates,
+                     size_t o_size, // intermediate nodes size in bytes
+                     size_t chunk_leaf_cnt,
+                     size_t wg_size,
+                     sycl::cl_ulong* const tx_ts)
+{
+  using word_t = typename H::word_t;
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(f.valid());
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(f.size() == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == leaf_cnt * H::NODE_LEN_BYTES);
+
+  if (chunk_leaf_cnt == 0) {
+    chunk_leaf_cnt = stream_chunk_leaf_cnt<H>(q);
+  }
+  chunk_leaf_cnt = std::min(chunk_leaf_cnt, leaf_cnt);
+
+  assert(chunk_leaf_cnt >= 2);
+  assert((chunk_leaf_cnt & (chunk_leaf_cnt - 1)) == 0);
+
+  const size_t chunk_cnt = leaf_cnt / chunk_leaf_cnt;
+  const size_t chunk_pair_cnt = chunk_leaf_cnt >> 1;
+  const size_t chunk_i_size = f.size() / chunk_cnt;
+  // # -of words of input, per chunk; as chunk has even many leaf nodes, each
+  // chunk begins at word boundary, even for SHA2-512/224
+  const size_t chunk_i_words = chunk_i_size / sizeof(word_t);
+
+  // first phase is dispatched once per chunk, while remaining phase is
+  // dispatched once per level of intermediate nodes
+  const size_t rounds =
+    static_cast<size_t>(sycl::log2(static_cast<double>(leaf_cnt >> 1)));
+
+  const word_t* const leaf_nodes = f.leaf_nodes<H>();
+
+  word_t* i_d[2];
+  i_d[0] = static_cast<word_t*>(sycl::malloc_device(chunk_i_size, q));
+  i_d[1] = static_cast<word_t*>(sycl::malloc_device(chunk_i_size, q));
+  assert(i_d[0] != nullptr && i_d[1] != nullptr);
+
+  std::vector<sycl::event> evts;
+  evts.reserve(chunk_cnt + rounds);
+
+  tx_ts[0] = 0;
+
+  sycl::event tx_evt = q.memcpy(i_d[0], leaf_nodes, chunk_i_size);
+
+  for (size_t c = 0; c < chunk_cnt; c++) {
+    tx_evt.wait();
+    tx_ts[0] += time_event(tx_evt);
+
+    // enqueue transfer of next chunk, before hashing current one, where its
+    // staging buffer was last read by first phase of previous chunk
+    if (c + 1 < chunk_cnt) {
+      if (c > 0) {
+        evts.back().wait();
+      }
+
+      tx_evt = q.memcpy(i_d[(c + 1) & 1],
+                        leaf_nodes + (c + 1) * chunk_i_words,
+                        chunk_i_size);
+    }
+
+    // staging buffer holds only this chunk, so it's hashed as leaf node pairs
+    // [0, chunk_pair_cnt) of tree, while intermediate nodes are shifted, so
+    // that they land where pairs [c * chunk_pair_cnt, (c + 1) * chunk_pair_cnt)
+    // of whole tree belong
+    evts.push_back(
+      merklize_phase0<H>(q,
+                         i_d[c & 1],
+                         leaf_cnt,
+                         intermediates + c * chunk_pair_cnt * H::NODE_WORDS,
+                         0,
+                         chunk_pair_cnt,
+                         std::min(wg_size, chunk_pair_cnt),
+                         {}));
+  }
+
+  merklize_phase1<H>(q, leaf_cnt, intermediates, wg_size, &evts);
+
+  // wait for last kernel dispatch round, where root of binary merkle tree is
+  // computed !
+  evts.back().wait();
+
+  sycl::free(i_d[0], q);
+  sycl::free(i_d[1], q);
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
+
+// Binary merklization of `leaf_cnt` -many ( power of 2 ) leaf nodes, living on
+// memory mapped file `f`, which must be of `leaf_cnt * DIGEST_LEN_BYTES` bytes
+//
+// Mapping is pageable memory, so when device supports system allocations, it's
+// passed to `merklize_zero_copy`, which lets first phase of merklization read
+// leaf nodes straight from page cache, so that cold file is faulted in by
+// kernel as it's consumed; otherwise it's staged on accelerator memory, chunk
+// by chunk, right from mapping, using `merklize_file_staged`, instead of
+// allocating accelerator memory as large as whole file
+//
+// Host to device data transfer time ( = 0, when read in place ) is written to
+// `tx_ts[0]`, while total kernel execution time is returned, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_file(sycl::queue& q,
+              const leaf_file& f,
+              size_t leaf_cnt,
+              typename H::word_t* const __restrict intermediates,
+              size_t o_size, // intermediate nodes size in bytes
+              size_t wg_size,
+              sycl::cl_ulong* const tx_ts)
+{
+  assert(f.valid());
+  assert(f.size() == leaf_cnt * H::DIGEST_LEN_BYTES);
+
+  if (!reads_in_place(q, leaf_input::pageable)) {
+    return merklize_file_staged<H>(
+      q, f, leaf_cnt, intermediates, o_size, 0, wg_size, tx_ts);
+  }
+
+  return merklize_zero_copy<H>(q,
+                               f.leaf_nodes<H>(),
+                               f.size(),
+                               leaf_cnt,
+                               intermediates,
+                               o_size,
+                               leaf_cnt - 1,
+                               wg_size,
+                               tx_ts);
+}
+
+// Out-of-core binary merklization of `leaf_cnt` -many ( power of 2 ) leaf
+// nodes, living on memory mapped file `f`, when they don't fit in accelerator
+// memory, using `merklize_stream`, where each chunk is copied to accelerator
+// memory right from mapping, while root is written to NODE_WORDS -many words of
+// `root`, living on host memory
+//
+// See `merklize_stream` for meaning of `chunk_leaf_cnt` & `tx_ts`; total kernel
+// execution time is returned, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_file_stream(sycl::queue& q,
+                     const leaf_file& f,
+                     size_t leaf_cnt,
+                     typename H::word_t* const root,
+                     size_t chunk_leaf_cnt,
+                     size_t wg_size,
+                     sycl::cl_ulong* const tx_ts)
+{
+  assert(f.valid());
+
+  return merklize_stream<H>(q,
+                            f.leaf_nodes<H>(),
+                            f.size(),
+                            leaf_cnt,
+                            root,
+                            chunk_leaf_cnt,
+                            wg_size,
+                            tx_ts);
+}
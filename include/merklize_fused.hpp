@@ -0,0 +1,177 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationFused;
+
+// Binary merklization, where each kernel dispatch computes multiple ( upto
+// `fused_lvl_cnt` ) consecutive levels of binary merkle tree, instead of just
+// one level, as done in `merklize` --- defined in merklize.hpp
+//
+// Each work-group computes its own subtree, by loading digests of lowest level
+// of subtree from global memory, then computing all upper levels of subtree
+// using work-group local memory ( synchronizing using work-group barriers ),
+// until root of subtree is reached
+//
+// All intermediate nodes are still written back to global memory, keeping same
+// output memory layout as `merklize`, but they're never read back from global
+// memory, except subtree roots, which are consumed by next kernel dispatch
+//
+// This reduces # -of kernel dispatches from log2(leaf_cnt) to ~ log2(leaf_cnt)
+// / fused_lvl_cnt and global memory reads for every level living inside
+// subtree
+//
+// Note, # -of levels fused in a single dispatch is also bounded by work-group
+// size, so that a work-group of size N can fuse at max log2(N) + 1 levels
+template<typename H>
+sycl::cl_ulong
+merklize_fused(sycl::queue& q,
+               const typename H::word_t* __restrict leaf_nodes,
+               size_t i_size, // leaf nodes size in bytes
+               size_t leaf_cnt,
+               typename H::word_t* const __restrict intermediates,
+               size_t o_size, // intermediate nodes size in bytes
+               size_t itmd_cnt,
+               size_t wg_size,
+               size_t fused_lvl_cnt)
+{
+  using word_t = typename H::word_t;
+
+  // A binary merkle tree with N -many leaf
+  // nodes should have (N - 1) -many intermediates
+  //
+  // Note N = power of 2
+  assert(leaf_cnt == itmd_cnt + 1);
+
+  assert(i_size == (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t));
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+  // subtree ( living inside a work-group ) must be a complete binary tree
+  assert((wg_size & (wg_size - 1)) == 0);
+  assert(fused_lvl_cnt > 0);
+
+  // At first N -many leaf nodes to be merged into
+  // N/ 2 -many intermediate nodes, which are living
+  // just above leaf nodes
+  const size_t work_item_cnt = leaf_cnt >> 1;
+
+  // validate whether this work group size can be used for next kernel dispatch
+  assert(wg_size <= work_item_cnt);
+
+  // these many levels of intermediate nodes to be computed
+  const size_t lvl_cnt =
+    static_cast<size_t>(sycl::log2(static_cast<double>(leaf_cnt)));
+
+  std::vector<sycl::event> evts;
+  // at max these many kernels to be dispatched
+  evts.reserve(lvl_cnt);
+
+  // lowest level ( = 1, where leaf nodes live at level 0 ) of intermediate
+  // nodes, to be computed in next kernel dispatch round
+  size_t lvl = 1;
+
+  while (lvl <= lvl_cnt) {
+    // # -of intermediate nodes living on lowest level of this dispatch round
+    const size_t work_item_cnt_ = leaf_cnt >> lvl;
+    const size_t wg_size_ =
+      wg_size <= work_item_cnt_ ? wg_size : work_item_cnt_;
+
+    // # -of levels which can be computed by this dispatch round
+    const size_t wg_lvl_cnt =
+      static_cast<size_t>(sycl::log2(static_cast<double>(wg_size_))) + 1;
+    const size_t fused_ = std::min(std::min(fused_lvl_cnt, wg_lvl_cnt),
+                                   lvl_cnt - lvl + 1);
+
+    const bool from_leaves = lvl == 1;
+    // offset ( in terms of nodes ) of lowest level of this dispatch round; its
+    // children living just below are placed at twice of that offset
+    const size_t o_offset = work_item_cnt_;
+
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      // each dispatch round depends on previously enqueued dispatch round
+      if (!evts.empty()) {
+        h.depends_on(evts.back());
+      }
+
+      // holds single intermediate node per work-item, which are consumed for
+      // computing intermediate nodes living on upper levels of subtree
+      sycl::accessor<word_t,
+                     1,
+                     sycl::access::mode::read_write,
+                     sycl::access::target::local>
+        lds{ sycl::range<1>{ wg_size_ * H::NODE_WORDS }, h };
+
+      h.parallel_for<kernelBinaryMerklizationFused<H>>(
+        sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt_ },
+                           sycl::range<1>{ wg_size_ } },
+        [=](sycl::nd_item<1> it) {
+          const size_t idx = it.get_global_linear_id();
+          const size_t lidx = it.get_local_linear_id();
+          const size_t grp = it.get_group_linear_id();
+
+          word_t digest[H::NODE_WORDS];
+
+          if (from_leaves) {
+            node::hash_leaves<H>(leaf_nodes + idx * H::LEAF_PAIR_WORDS, digest);
+          } else {
+            node::hash_nodes<H>(
+              intermediates + ((o_offset << 1) + (idx << 1)) * H::NODE_WORDS,
+              digest);
+          }
+
+#pragma unroll 8
+          for (size_t i = 0; i < H::NODE_WORDS; i++) {
+            lds[lidx * H::NODE_WORDS + i] = digest[i];
+            intermediates[(o_offset + idx) * H::NODE_WORDS + i] = digest[i];
+          }
+
+          // upper levels of subtree, computed from work-group local memory
+          for (size_t l = 1; l < fused_; l++) {
+            // # -of active work-items, for computing this level of subtree
+            const size_t active = wg_size_ >> l;
+
+            it.barrier(sycl::access::fence_space::local_space);
+
+            if (lidx < active) {
+              node::hash_nodes<H>(&lds[(lidx << 1) * H::NODE_WORDS], digest);
+            }
+
+            // ensure all reads of local memory are done, before it's updated
+            it.barrier(sycl::access::fence_space::local_space);
+
+            if (lidx < active) {
+              const size_t o_idx = (o_offset >> l) + grp * active + lidx;
+
+#pragma unroll 8
+              for (size_t i = 0; i < H::NODE_WORDS; i++) {
+                lds[lidx * H::NODE_WORDS + i] = digest[i];
+                intermediates[o_idx * H::NODE_WORDS + i] = digest[i];
+              }
+            }
+          }
+        });
+    });
+    evts.push_back(evt);
+
+    lvl += fused_;
+  }
+
+  // wait for last kernel dispatch round, where root of binary merkle tree is
+  // computed !
+  evts.back().wait();
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// Computes all intermediate nodes living on level which has `node_cnt` -many
+// nodes ( at node index [node_cnt, 2 * node_cnt) ), on host, from their
+// children living just below, by splitting level into equal sized chunks, each
+// of them being processed by a host thread
+//
+// Note, `nodes` holds intermediate nodes of binary merkle tree, following same
+// memory layout as `merklize` --- defined in merklize.hpp
+template<typename H>
+void
+host_merklize_level(typename H::word_t* const nodes, size_t node_cnt)
+{
+  // not spawning threads, when very few nodes are to be computed, as thread
+  // creation cost will dominate
+  constexpr size_t min_nodes_per_thread = 1 << 6;
+
+  const size_t hw_thread_cnt =
+    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u));
+  const size_t thread_cnt = std::max(
+    std::min(hw_thread_cnt, node_cnt / min_nodes_per_thread), size_t(1));
+  const size_t per_thread = (node_cnt + thread_cnt - 1) / thread_cnt;
+
+  auto merklize_chunk = [=](size_t frm, size_t to) {
+    for (size_t i = frm; i < to; i++) {
+      const size_t n_idx = node_cnt + i;
+      node::hash_nodes<H>(nodes + (n_idx << 1) * H::NODE_WORDS,
+                          nodes + n_idx * H::NODE_WORDS);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_cnt - 1);
+
+  for (size_t t = 1; t < thread_cnt; t++) {
+    const size_t frm = std::min(t * per_thread, node_cnt);
+    const size_t to = std::min(frm + per_thread, node_cnt);
+    threads.emplace_back(merklize_chunk, frm, to);
+  }
+
+  // calling thread also takes its share of work
+  merklize_chunk(0, std::min(per_thread, node_cnt));
+
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationHybrid;
+
+// Binary merklization, where lower levels of tree are computed on accelerator,
+// dispatching one kernel per level ( just like `merklize` ), until # -of nodes
+// on level to be computed drops to `host_node_cnt` or lesser; from there on
+// all upper levels of tree are computed on host
+//
+// For doing so, last level computed on accelerator is brought to host, using a
+// single small device to host data transfer, then remaining levels are computed
+// on host threads and finally all host computed intermediate nodes are copied
+// back to accelerator, living in same memory layout as `merklize` produces
+//
+// Narrow upper levels of tree are otherwise computed by kernel dispatches
+// having very few work-items, where dispatch cost dominates hashing cost
+//
+// Lowest level of intermediate nodes ( = 1, where leaf nodes live at level 0 )
+// is always computed on accelerator, while passing `host_node_cnt` = 0 results
+// into all levels being computed on accelerator
+//
+// Level ( >= 2 ) from where intermediate nodes are computed on host, is written
+// to `cutover_lvl`; when no level is computed on host, it's set to lvl_cnt + 1
+//
+// Returned time ( in nanosecond ) accounts for all kernel executions, data
+// transfers between host and accelerator & host side computation
+template<typename H>
+sycl::cl_ulong
+merklize_hybrid(sycl::queue& q,
+                const typename H::word_t* __restrict leaf_nodes,
+                size_t i_size, // leaf nodes size in bytes
+                size_t leaf_cnt,
+                typename H::word_t* const __restrict intermediates,
+                size_t o_size, // intermediate nodes size in bytes
+                size_t itmd_cnt,
+                size_t wg_size,
+                size_t host_node_cnt,
+                size_t* const cutover_lvl)
+{
+  using word_t = typename H::word_t;
+
+  // A binary merkle tree with N -many leaf
+  // nodes should have (N - 1) -many intermediates
+  //
+  // Note N = power of 2
+  assert(leaf_cnt == itmd_cnt + 1);
+
+  assert(i_size == (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t));
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+  // At first N -many leaf nodes to be merged into
+  // N/ 2 -many intermediate nodes, which are living
+  // just above leaf nodes
+  const size_t work_item_cnt = leaf_cnt >> 1;
+
+  // validate whether this work group size can be used for kernel dispatch
+  assert(wg_size <= work_item_cnt);
+
+  // these many levels of intermediate nodes to be computed
+  const size_t lvl_cnt =
+    static_cast<size_t>(sycl::log2(static_cast<double>(leaf_cnt)));
+
+  // find first level to be computed on host
+  size_t cutover = 2;
+  while (cutover <= lvl_cnt && (leaf_cnt >> cutover) > host_node_cnt) {
+    cutover++;
+  }
+
+  std::vector<sycl::event> evts;
+  evts.reserve(cutover - 1);
+
+  for (size_t lvl = 1; lvl < cutover; lvl++) {
+    const size_t work_item_cnt_ = leaf_cnt >> lvl;
+    const size_t wg_size_ =
+      wg_size <= work_item_cnt_ ? wg_size : work_item_cnt_;
+    const size_t o_offset = work_item_cnt_;
+    const bool from_leaves = lvl == 1;
+
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      // each level depends on previous level being computed
+      if (!evts.empty()) {
+        h.depends_on(evts.back());
+      }
+
+      h.parallel_for<kernelBinaryMerklizationHybrid<H>>(
+        sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt_ },
+                           sycl::range<1>{ wg_size_ } },
+        [=](sycl::nd_item<1> it) {
+          const size_t idx = it.get_global_linear_id();
+          word_t* const out = intermediates + (o_offset + idx) * H::NODE_WORDS;
+
+          if (from_leaves) {
+            node::hash_leaves<H>(leaf_nodes + idx * H::LEAF_PAIR_WORDS, out);
+          } else {
+            node::hash_nodes<H>(
+              intermediates + ((o_offset << 1) + (idx << 1)) * H::NODE_WORDS,
+              out);
+          }
+        });
+    });
+    evts.push_back(evt);
+  }
+
+  sycl::cl_ulong ts = 0;
+
+  if (cutover <= lvl_cnt) {
+    // # -of nodes on last level computed on accelerator, which are living at
+    // node index [m, 2 * m)
+    const size_t m = leaf_cnt >> (cutover - 1);
+    const size_t m_size = m * H::NODE_LEN_BYTES;
+
+    word_t* nodes_h = static_cast<word_t*>(sycl::malloc_host(m_size << 1, q));
+
+    sycl::event evt_0 = q.submit([&](sycl::handler& h) {
+      h.depends_on(evts.back());
+      h.memcpy(nodes_h + m * H::NODE_WORDS,
+               intermediates + m * H::NODE_WORDS,
+               m_size);
+    });
+    evt_0.wait();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t n = m >> 1; n > 0; n >>= 1) {
+      host_merklize_level<H>(nodes_h, n);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // node index 0 is never used, so is not copied back
+    sycl::event evt_1 = q.memcpy(intermediates + H::NODE_WORDS,
+                                 nodes_h + H::NODE_WORDS,
+                                 m_size - H::NODE_LEN_BYTES);
+    evt_1.wait();
+
+    sycl::free(nodes_h, q);
+
+    ts += time_event(evt_0) + time_event(evt_1);
+    ts += static_cast<sycl::cl_ulong>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+        .count());
+  } else {
+    evts.back().wait();
+  }
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  *cutover_lvl = cutover;
+
+  // return total execution cost, in terms of nanosecond
+  return ts;
+}
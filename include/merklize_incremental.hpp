@@ -0,0 +1,247 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+// Append-only binary merkle tree, which doesn't keep all leaf nodes around,
+// rather it only keeps right-edge frontier of tree i.e. roots of ( at max
+// log2(leaf_cnt) + 1 -many ) complete subtrees, which current leaf nodes can be
+// partitioned into, from left to right, in decreasing order of their size
+//
+// Frontier node at level `l` is valid only when bit `l` of current leaf count
+// is set, where it's root of complete subtree having 2 ^ l -many leaf nodes
+//
+// Root of tree is computed by folding frontier from lowest to highest level,
+// which results into same root as `merklize_arbitrary` produces, with
+// `odd_node_policy::promote` ( or `odd_node_policy::rfc6962` ), when all leaf
+// nodes are merklized at once; when leaf count is power of 2, it's same root as
+// `merklize` produces
+//
+// Leaf nodes can be appended one by one ( on host ) or in batches, where
+// complete subtrees of batch, having at least `device_leaf_cnt` -many leaf
+// nodes, are merklized on accelerator using `merklize`, while only their roots
+// are brought back to host and merged into frontier
+//
+// Appends & root queries are serialized using a mutex, so that multiple
+// producers can append concurrently, while leaf nodes of each batch always
+// occupy consecutive positions in tree
+template<typename H>
+class incremental_tree
+{
+public:
+  using word_t = typename H::word_t;
+
+  incremental_tree(sycl::queue& q, size_t device_leaf_cnt, size_t wg_size)
+    : q(q)
+    , device_leaf_cnt(device_leaf_cnt)
+    , wg_size(wg_size)
+    , leaf_cnt(0)
+    , frontier(max_lvl_cnt * H::NODE_WORDS, 0)
+  {
+    // accelerator merklizes trees having at least 2 leaf nodes
+    assert(device_leaf_cnt >= 2);
+  }
+
+  // Appends single leaf node, which is represented using NODE_WORDS -many words
+  // ( see `node::leaf_to_node` in merklize.hpp )
+  void append(const word_t* const leaf)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    insert(0, leaf);
+  }
+
+  // Appends `cnt` -many leaf nodes, living on host memory, which are provided
+  // as ceil(cnt / 2) -many pairs of consecutive leaf nodes ( = LEAF_PAIR_WORDS
+  // -many words each ), just like `merklize_arbitrary` expects them
+  //
+  // Batch is split into complete subtrees, each of them aligned to current
+  // leaf count, so that its root can be merged into frontier; subtrees having
+  // at least `device_leaf_cnt` -many leaf nodes are merklized on accelerator,
+  // while others are appended leaf by leaf, on host
+  //
+  // Returns total kernel execution time, in nanoseconds
+  sycl::cl_ulong append_batch(const word_t* const leaves, size_t cnt)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // largest complete subtree which can be merklized on accelerator
+    size_t max_sub_cnt = 1;
+    while ((max_sub_cnt << 1) <= cnt) {
+      max_sub_cnt <<= 1;
+    }
+
+    word_t* i_d = nullptr;
+    word_t* o_d = nullptr;
+    std::vector<word_t> staging;
+
+    if (max_sub_cnt >= device_leaf_cnt) {
+      const size_t i_size = max_sub_cnt * H::DIGEST_LEN_BYTES;
+      const size_t o_size = max_sub_cnt * H::NODE_LEN_BYTES;
+
+      i_d = static_cast<word_t*>(sycl::malloc_device(i_size, q));
+      o_d = static_cast<word_t*>(sycl::malloc_device(o_size, q));
+    }
+
+    sycl::cl_ulong ts = 0;
+    size_t i = 0;
+
+    while (i < cnt) {
+      // largest power of 2 subtree, which fits into remaining leaf nodes &
+      // is aligned to current leaf count
+      size_t sub_cnt = 1;
+      while ((sub_cnt << 1) <= cnt - i &&
+             (leaf_cnt == 0 || (leaf_cnt & ((sub_cnt << 1) - 1)) == 0)) {
+        sub_cnt <<= 1;
+      }
+
+      if (sub_cnt < device_leaf_cnt) {
+        word_t leaf[H::NODE_WORDS];
+
+        node::leaf_at<H>(leaves, i, leaf);
+        insert(0, leaf);
+
+        i++;
+        continue;
+      }
+
+      const size_t i_size = sub_cnt * H::DIGEST_LEN_BYTES;
+      const size_t o_size = sub_cnt * H::NODE_LEN_BYTES;
+
+      const size_t frm = (i * H::DIGEST_LEN_BYTES) / sizeof(word_t);
+
+      if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+        if ((i & 1) == 1) {
+          // SHA2-512/224 leaf nodes are 28 -bytes wide, so subtree starting at
+          // odd leaf index doesn't begin at word boundary; shift those leaf
+          // nodes left by 32 -bits, so that they're word aligned
+          const size_t w_cnt = i_size / sizeof(word_t);
+
+          staging.resize(w_cnt);
+          for (size_t j = 0; j < w_cnt; j++) {
+            staging[j] = (leaves[frm + j] << 32) | (leaves[frm + j + 1] >> 32);
+          }
+
+          q.memcpy(i_d, staging.data(), i_size).wait();
+        } else {
+          q.memcpy(i_d, leaves + frm, i_size).wait();
+        }
+      } else {
+        q.memcpy(i_d, leaves + frm, i_size).wait();
+      }
+
+      ts += merklize<H>(q,
+                        i_d,
+                        i_size,
+                        sub_cnt,
+                        o_d,
+                        o_size,
+                        sub_cnt - 1,
+                        std::min(wg_size, sub_cnt >> 1));
+
+      // only root of subtree is required
+      word_t root[H::NODE_WORDS];
+      q.memcpy(root, o_d + H::NODE_WORDS, H::NODE_LEN_BYTES).wait();
+
+      size_t lvl = 0;
+      while ((1ul << lvl) < sub_cnt) {
+        lvl++;
+      }
+      insert(lvl, root);
+
+      i += sub_cnt;
+    }
+
+    if (i_d != nullptr) {
+      sycl::free(i_d, q);
+      sycl::free(o_d, q);
+    }
+
+    return ts;
+  }
+
+  // Writes current root of tree to NODE_WORDS -many words of `out`, returning
+  // # -of leaf nodes which it commits to; when tree is empty, `out` is not
+  // touched & 0 is returned
+  size_t root(word_t* const out)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (leaf_cnt == 0) {
+      return 0;
+    }
+
+    size_t lvl = 0;
+    while (((leaf_cnt >> lvl) & 1) == 0) {
+      lvl++;
+    }
+
+    word_t acc[H::NODE_WORDS];
+    std::copy(node_at(lvl), node_at(lvl) + H::NODE_WORDS, acc);
+
+    for (lvl = lvl + 1; lvl < max_lvl_cnt; lvl++) {
+      if (((leaf_cnt >> lvl) & 1) == 1) {
+        hash_pair(node_at(lvl), acc, acc);
+      }
+    }
+
+    std::copy(acc, acc + H::NODE_WORDS, out);
+    return leaf_cnt;
+  }
+
+  // # -of leaf nodes appended so far
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    return leaf_cnt;
+  }
+
+private:
+  // frontier can't be taller than this, as leaf count is 64 -bit
+  static constexpr size_t max_lvl_cnt = 64;
+
+  sycl::queue& q;
+  const size_t device_leaf_cnt;
+  const size_t wg_size;
+
+  size_t leaf_cnt;
+  std::vector<word_t> frontier;
+  std::mutex mtx;
+
+  word_t* node_at(size_t lvl) { return frontier.data() + lvl * H::NODE_WORDS; }
+
+  // 2-to-1 hashes intermediate nodes `a` & `b`, writing digest to `out`, which
+  // may be same as `b`
+  static void hash_pair(const word_t* const a,
+                        const word_t* const b,
+                        word_t* const out)
+  {
+    word_t in_words[H::NODE_WORDS << 1];
+
+    std::copy(a, a + H::NODE_WORDS, in_words);
+    std::copy(b, b + H::NODE_WORDS, in_words + H::NODE_WORDS);
+
+    node::hash_nodes<H>(in_words, out);
+  }
+
+  // Merges root of complete subtree having 2 ^ lvl -many leaf nodes into
+  // frontier, where current leaf count must be multiple of 2 ^ lvl; just like
+  // adding 2 ^ lvl to a binary counter, carrying over to higher levels, as long
+  // as frontier nodes are already present there
+  void insert(size_t lvl, const word_t* const sub_root)
+  {
+    word_t acc[H::NODE_WORDS];
+    std::copy(sub_root, sub_root + H::NODE_WORDS, acc);
+
+    size_t lvl_ = lvl;
+    while (((leaf_cnt >> lvl_) & 1) == 1) {
+      hash_pair(node_at(lvl_), acc, acc);
+      lvl_++;
+    }
+
+    std::copy(acc, acc + H::NODE_WORDS, node_at(lvl_));
+    leaf_cnt += 1ul << lvl;
+  }
+};
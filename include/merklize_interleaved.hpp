@@ -0,0 +1,90 @@
+#pragma once
+#include "merklize.hpp"
+
+// Kernel name
+class kernelExportInterleavedNodes;
+
+// Converts `node_cnt` -many intermediate nodes, living at node index
+// [node_off, node_off + node_cnt) of tree computed by `merklize_interleaved` (
+// i.e. in bit interleaved form ), to standard 32 -bytes Keccak-256 digests,
+// which are written consecutively to `out`, using one work-item per node
+//
+// Global range is rounded up to multiple of `wg_size`, while work-items
+// beyond last node do nothing
+sycl::event
+export_interleaved_nodes(sycl::queue& q,
+                         const sycl::uint* const __restrict intermediates,
+                         size_t node_off,
+                         size_t node_cnt,
+                         sycl::uchar* const __restrict out,
+                         size_t wg_size,
+                         const std::vector<sycl::event>& deps)
+{
+  using H = hasher::keccak_256_interleaved;
+
+  const size_t glb_size = ((node_cnt + wg_size - 1) / wg_size) * wg_size;
+
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+
+    h.parallel_for<kernelExportInterleavedNodes>(
+      sycl::nd_range<1>{ sycl::range<1>{ glb_size },
+                         sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) {
+        const size_t idx = it.get_global_linear_id();
+        if (idx >= node_cnt) {
+          return;
+        }
+
+        keccak_256::to_digest_bytes(
+          intermediates + (node_off + idx) * H::NODE_WORDS,
+          out + idx * H::NODE_LEN_BYTES);
+      });
+  });
+}
+
+// Binary merklization using Keccak-256, where intermediate nodes of all tree
+// levels are kept in bit interleaved form ( see `keccak_256_interleaved` hasher
+// policy ), so that lanes are converted to bit interleaved form only once, when
+// leaf nodes are hashed in first phase, while each intermediate level consumes
+// & produces bit interleaved lanes directly, as 32 -bit words
+//
+// Leaf nodes are standard 32 -bytes digests, same as `merklize` expects for
+// Keccak-256, while `intermediates` receives eight 32 -bit words per node,
+// following same memory layout as `merklize` produces; only root is converted
+// back to standard form, which is written to 32 -bytes `root`, living on host
+// memory; use `export_interleaved_nodes` for converting other nodes, when
+// they're required
+//
+// Returned time ( in nanosecond ) accounts for all kernel executions
+sycl::cl_ulong
+merklize_interleaved(sycl::queue& q,
+                     const sycl::uchar* __restrict leaf_nodes,
+                     size_t i_size, // leaf nodes size in bytes
+                     size_t leaf_cnt,
+                     sycl::uint* const __restrict intermediates,
+                     size_t o_size, // intermediate nodes size in bytes
+                     size_t itmd_cnt,
+                     size_t wg_size,
+                     sycl::uchar* const root)
+{
+  using H = hasher::keccak_256_interleaved;
+
+  const sycl::cl_ulong ts =
+    merklize<H>(q,
+                reinterpret_cast<const sycl::uint*>(leaf_nodes),
+                i_size,
+                leaf_cnt,
+                intermediates,
+                o_size,
+                itmd_cnt,
+                wg_size);
+
+  sycl::uint root_words[H::NODE_WORDS];
+  q.memcpy(root_words, intermediates + H::NODE_WORDS, H::NODE_LEN_BYTES)
+    .wait();
+
+  keccak_256::to_digest_bytes(root_words, root);
+
+  return ts;
+}
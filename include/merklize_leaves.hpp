@@ -0,0 +1,164 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <vector>
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelLeafHashing;
+
+// Hashes `leaf_cnt` -many raw leaf data records ( of arbitrary length ),
+// living on accelerator memory `data`, one after another, into leaf nodes,
+// using `hash_message` of hasher policy, in single kernel dispatch, so that raw
+// data doesn't need to be hashed on host before it can be merklized
+//
+// Record `i` occupies byte [offs[i], offs[i + 1]) of `data`, where `offs` is
+// host memory holding (leaf_cnt + 1) -many byte offsets, in ascending order
+//
+// Leaf nodes are written to `leaf_nodes` ( accelerator memory ) as pairs of
+// consecutive leaf nodes, exactly as `merklize` expects them, so it must be of
+// ceil(leaf_cnt / 2) * LEAF_PAIR_WORDS -many words; when `leaf_cnt` is odd,
+// last leaf node is paired with zero node
+//
+// Each work-item hashes both leaf nodes of a pair, as for SHA2-512/224 they
+// share one 64 -bit word
+//
+// Returns kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+hash_leaf_data(sycl::queue& q,
+               const sycl::uchar* const __restrict data,
+               const size_t* const offs,
+               size_t leaf_cnt,
+               typename H::word_t* const __restrict leaf_nodes,
+               size_t o_size, // leaf nodes size in bytes
+               size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  const size_t pair_cnt = (leaf_cnt + 1) >> 1;
+
+  assert(o_size == pair_cnt * H::LEAF_PAIR_WORDS * sizeof(word_t));
+
+  if (leaf_cnt == 0) {
+    return 0;
+  }
+
+  const size_t offs_size = sizeof(size_t) * (leaf_cnt + 1);
+  size_t* offs_d = static_cast<size_t*>(sycl::malloc_device(offs_size, q));
+
+  sycl::event evt_0 = q.memcpy(offs_d, offs, offs_size);
+
+  // global range is rounded up to multiple of work-group size, while surplus
+  // work-items don't do anything
+  const size_t wg_size_ = std::min(wg_size, pair_cnt);
+  const size_t work_item_cnt =
+    ((pair_cnt + wg_size_ - 1) / wg_size_) * wg_size_;
+
+  sycl::event evt_1 = q.submit([&](sycl::handler& h) {
+    h.depends_on(evt_0);
+
+    h.parallel_for<kernelLeafHashing<H>>(
+      sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                         sycl::range<1>{ wg_size_ } },
+      [=](sycl::nd_item<1> it) {
+        const size_t idx = it.get_global_linear_id();
+        if (idx >= pair_cnt) {
+          return;
+        }
+
+#pragma unroll 2
+        for (size_t j = 0; j < 2; j++) {
+          const size_t l_idx = (idx << 1) + j;
+          word_t leaf[H::NODE_WORDS];
+
+          if (l_idx < leaf_cnt) {
+            const size_t off = offs_d[l_idx];
+            H::hash_message(data + off, offs_d[l_idx + 1] - off, leaf);
+          } else {
+#pragma unroll 8
+            for (size_t i = 0; i < H::NODE_WORDS; i++) {
+              leaf[i] = 0;
+            }
+          }
+
+          node::put_leaf_at<H>(leaf, l_idx, leaf_nodes);
+        }
+      });
+  });
+  evt_1.wait();
+
+  sycl::free(offs_d, q);
+
+  return time_event(evt_1);
+}
+
+// Hashes `leaf_cnt` -many raw leaf data records, each of `leaf_len` -bytes,
+// living on accelerator memory `data`, one after another, into leaf nodes; see
+// above routine
+template<typename H>
+sycl::cl_ulong
+hash_leaf_data(sycl::queue& q,
+               const sycl::uchar* const __restrict data,
+               size_t leaf_len,
+               size_t leaf_cnt,
+               typename H::word_t* const __restrict leaf_nodes,
+               size_t o_size, // leaf nodes size in bytes
+               size_t wg_size)
+{
+  std::vector<size_t> offs(leaf_cnt + 1);
+  for (size_t i = 0; i <= leaf_cnt; i++) {
+    offs[i] = i * leaf_len;
+  }
+
+  return hash_leaf_data<H>(
+    q, data, offs.data(), leaf_cnt, leaf_nodes, o_size, wg_size);
+}
+
+// Binary merklization of `leaf_cnt` -many ( power of 2 ) raw leaf data
+// records, living on accelerator memory `data`, where record `i` occupies byte
+// [offs[i], offs[i + 1]) of `data`, while `offs` is host memory
+//
+// Leaf nodes are computed on accelerator using `hash_leaf_data`, into a
+// temporary allocation, which is then merklized using `merklize`, writing
+// intermediate nodes to `intermediates`, in same layout
+//
+// Returns total kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_raw(sycl::queue& q,
+             const sycl::uchar* const __restrict data,
+             const size_t* const offs,
+             size_t leaf_cnt,
+             typename H::word_t* const __restrict intermediates,
+             size_t o_size, // intermediate nodes size in bytes
+             size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+  const size_t pair_cnt = leaf_cnt >> 1;
+  const size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+
+  word_t* leaf_nodes = static_cast<word_t*>(sycl::malloc_device(i_size, q));
+
+  sycl::cl_ulong ts = hash_leaf_data<H>(
+    q, data, offs, leaf_cnt, leaf_nodes, i_size, wg_size);
+  ts += merklize<H>(q,
+                    leaf_nodes,
+                    i_size,
+                    leaf_cnt,
+                    intermediates,
+                    o_size,
+                    leaf_cnt - 1,
+                    std::min(wg_size, pair_cnt));
+
+  sycl::free(leaf_nodes, q);
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <vector>
+
+// How much of binary merkle tree is to be materialized in output memory
+// allocation, when merklizing using `merklize_materialize`
+enum class materialization
+{
+  full, // all intermediate nodes, same as `merklize`
+  cap,  // only top `cap_lvl_cnt` -many levels ( i.e. merkle cap )
+  root, // only root, while leaf nodes may be overwritten
+};
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationLevel;
+
+// # -of nodes ( including never used node 0 ) required for keeping top
+// `cap_lvl_cnt` -many levels of tree with `leaf_cnt` -many leaf nodes ( power
+// of 2 ), which never exceeds `leaf_cnt`, however large `cap_lvl_cnt` is
+inline size_t
+cap_node_cnt(size_t leaf_cnt, size_t cap_lvl_cnt)
+{
+  // shifting 64 -bit word by >= 64 bits is undefined, while any such cap
+  // covers whole tree anyway
+  return cap_lvl_cnt < 64 ? std::min(leaf_cnt, 1ul << cap_lvl_cnt) : leaf_cnt;
+}
+
+// Computes size of output memory allocation ( in bytes ), required for
+// materializing binary merkle tree with `leaf_cnt` -many leaf nodes ( power of
+// 2 ), using `mode`
+//
+// With `materialization::cap`, (2 ^ cap_lvl_cnt) -many nodes are required,
+// where node 0 is never used, just like `merklize` output
+template<typename H>
+size_t
+materialized_size(materialization mode, size_t leaf_cnt, size_t cap_lvl_cnt)
+{
+  switch (mode) {
+    case materialization::cap:
+      return cap_node_cnt(leaf_cnt, cap_lvl_cnt) * H::NODE_LEN_BYTES;
+    case materialization::root:
+      return H::NODE_LEN_BYTES;
+    default:
+      return leaf_cnt * H::NODE_LEN_BYTES;
+  }
+}
+
+// Binary merklization, where only part of tree, chosen using `mode`, is
+// written to output memory allocation `out`, living on accelerator, which
+// must be of `materialized_size` bytes
+//
+// - `materialization::full` is same as `merklize`
+// - `materialization::cap` keeps top `cap_lvl_cnt` -many levels of tree i.e.
+// nodes living at index [1, 2 ^ cap_lvl_cnt) of `merklize` output, in same
+// layout
+// - `materialization::root` keeps only root, in NODE_WORDS -many words
+//
+// With both of latter two modes, tree is reduced in place, on `leaf_nodes`,
+// which is why leaf nodes are overwritten, while no scratch memory is used at
+// all; on level having m = (leaf_cnt >> (r + 1)) -many nodes, i-th node is
+// written at start of memory, where i-th ( of m ) equal sized chunk of leaf
+// nodes used to live, reading its children from start of both halves of that
+// chunk, so that no two work-items touch same memory, while each node fits in
+// space of a leaf node pair ( also for SHA2-512/224 ); nodes of levels being
+// kept are also written to `out`
+//
+// So, instead of an intermediate node allocation as large as leaf nodes,
+// caller only requires a few KB of output memory, which is also all that has
+// to be transferred back to host, halving device memory requirement
+//
+// Returns total kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_materialize(sycl::queue& q,
+                     typename H::word_t* const leaf_nodes,
+                     size_t i_size, // leaf nodes size in bytes
+                     size_t leaf_cnt,
+                     materialization mode,
+                     size_t cap_lvl_cnt,
+                     typename H::word_t* const out,
+                     size_t o_size, // output size in bytes
+                     size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(i_size == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == materialized_size<H>(mode, leaf_cnt, cap_lvl_cnt));
+
+  const size_t pair_cnt = leaf_cnt >> 1;
+
+  if (mode == materialization::full) {
+    return merklize<H>(q,
+                       leaf_nodes,
+                       i_size,
+                       leaf_cnt,
+                       out,
+                       o_size,
+                       leaf_cnt - 1,
+                       std::min(wg_size, pair_cnt));
+  }
+
+  assert(mode == materialization::root || cap_lvl_cnt >= 1);
+
+  // levels having fewer nodes than this, are written to `out`
+  const size_t cap_cnt =
+    mode == materialization::cap ? cap_node_cnt(leaf_cnt, cap_lvl_cnt) : 0;
+
+  std::vector<sycl::event> evts;
+
+  // level `r` has m = (pair_cnt >> r) -many nodes
+  for (size_t r = 0; (pair_cnt >> r) > 0; r++) {
+    const size_t m = pair_cnt >> r;
+    const bool from_leaves = r == 0;
+
+    // distance between consecutive nodes of this level, in `leaf_nodes`, in
+    // terms of words
+    const size_t stride = (1ul << r) * H::LEAF_PAIR_WORDS;
+
+    // nodes of this level are also written to `out`, from index `out_off`
+    const bool kept = m < cap_cnt || (mode == materialization::root && m == 1);
+    const size_t out_off = mode == materialization::cap ? m : 0;
+
+    const size_t wg_size_ = std::min(wg_size, m);
+
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      // each level depends on previous level being computed
+      if (!evts.empty()) {
+        h.depends_on(evts.back());
+      }
+
+      h.parallel_for<kernelBinaryMerklizationLevel<H>>(
+        sycl::nd_range<1>{ sycl::range<1>{ m }, sycl::range<1>{ wg_size_ } },
+        [=](sycl::nd_item<1> it) {
+          const size_t idx = it.get_global_linear_id();
+          word_t* const chunk = leaf_nodes + idx * stride;
+
+          word_t node_[H::NODE_WORDS];
+
+          if (from_leaves) {
+            node::hash_leaves<H>(chunk, node_);
+          } else {
+            // children aren't consecutive, so they're gathered first
+            word_t in_words[H::NODE_WORDS << 1];
+#pragma unroll 8
+            for (size_t i = 0; i < H::NODE_WORDS; i++) {
+              in_words[i] = chunk[i];
+              in_words[H::NODE_WORDS + i] = chunk[(stride >> 1) + i];
+            }
+
+            node::hash_nodes<H>(in_words, node_);
+          }
+
+#pragma unroll 8
+          for (size_t i = 0; i < H::NODE_WORDS; i++) {
+            chunk[i] = node_[i];
+          }
+
+          if (kept) {
+            word_t* const o = out + (out_off + idx) * H::NODE_WORDS;
+#pragma unroll 8
+            for (size_t i = 0; i < H::NODE_WORDS; i++) {
+              o[i] = node_[i];
+            }
+          }
+        });
+    });
+    evts.push_back(evt);
+  }
+
+  // wait for last kernel dispatch, where root is computed
+  evts.back().wait();
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Partitions device `d` by NUMA affinity domain ( say one sub-device per socket
+// of a multi-socket CPU ), creating one queue per sub-device, with profiling
+// enabled; when device can't be partitioned that way, a single queue targeting
+// whole device is returned
+//
+// All returned queues share one context, which is not same as context of any
+// other queue targeting `d`, so USM buffers passed to `merklize_numa` are to be
+// allocated using first of returned queues; as partitioning device isn't cheap,
+// queues are meant to be created once & reused across `merklize_numa` calls
+std::vector<sycl::queue>
+numa_queues(const sycl::device& d)
+{
+  std::vector<sycl::device> sub_devs;
+
+  if (d.get_info<sycl::info::device::partition_max_sub_devices>() > 1) {
+    try {
+      sub_devs = d.create_sub_devices<
+        sycl::info::partition_property::partition_by_affinity_domain>(
+        sycl::info::partition_affinity_domain::numa);
+    } catch (const sycl::exception&) {
+      sub_devs.clear();
+    }
+  }
+
+  std::vector<sycl::queue> qs;
+
+  if (sub_devs.empty()) {
+    qs.emplace_back(d, sycl::property::queue::enable_profiling{});
+    return qs;
+  }
+
+  sycl::context c{ sub_devs };
+  qs.reserve(sub_devs.size());
+
+  for (const sycl::device& sub_d : sub_devs) {
+    qs.emplace_back(c, sub_d, sycl::property::queue::enable_profiling{});
+  }
+
+  return qs;
+}
+
+// Binary merklization of `leaf_cnt` -many leaf nodes ( power of 2 ), living on
+// host memory, across NUMA domains, each targeted by one queue of `qs` ( see
+// `numa_queues` ), such that leaf nodes are split into P -many equal slices,
+// where P is largest power of 2 <= min(qs.size(), leaf_cnt / 2)
+//
+// Each slice is merklized into an independent subtree by its own NUMA domain,
+// driven by one host thread, where leaf & intermediate nodes of subtree live on
+// device memory allocated by that domain's queue; both buffers are zeroed by
+// that domain before leaf nodes are copied in, so that pages are first-touched
+// ( i.e. placed ) by cores of same socket, which later hash them
+//
+// Subtrees are copied back, level by level, into `intermediates`, living on
+// host memory, following same memory layout as `merklize` produces, while only
+// (P - 1) -many nodes above subtree roots are computed on host, at the end
+//
+// Largest host to device & device to host data transfer time ( among all
+// domains ) is written to `tx_ts[0]` & `tx_ts[1]` respectively, while largest
+// kernel execution time is returned, all in nanoseconds, as domains run
+// concurrently
+//
+// All queues of `qs` must share one context ( as `numa_queues` creates them ),
+// while `leaf_nodes` & `intermediates` must either be pageable host memory or
+// USM allocated from that same context ( say `sycl::malloc_host(.., qs[0])` ),
+// as using USM pointer of another context is undefined; host USM of that
+// context lets domains copy to/ from pinned memory
+template<typename H>
+sycl::cl_ulong
+merklize_numa(std::vector<sycl::queue>& qs,
+              const typename H::word_t* const leaf_nodes,
+              size_t i_size, // leaf nodes size in bytes
+              size_t leaf_cnt,
+              typename H::word_t* const intermediates,
+              size_t o_size, // intermediate nodes size in bytes
+              size_t wg_size,
+              sycl::cl_ulong* const tx_ts)
+{
+  using word_t = typename H::word_t;
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(i_size == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == leaf_cnt * H::NODE_LEN_BYTES);
+  assert(!qs.empty());
+  assert(std::all_of(qs.begin(), qs.end(), [&](const sycl::queue& q) {
+    return q.get_context() == qs[0].get_context();
+  }));
+
+  // each domain gets at least two leaf nodes
+  size_t part_cnt = 1;
+  while ((part_cnt << 1) <= std::min(qs.size(), leaf_cnt >> 1)) {
+    part_cnt <<= 1;
+  }
+
+  const size_t part_leaf_cnt = leaf_cnt / part_cnt;
+  const size_t part_i_size = i_size / part_cnt;
+  const size_t part_o_size = part_leaf_cnt * H::NODE_LEN_BYTES;
+  // slice has even many leaf nodes, so it begins at word boundary, even for
+  // SHA2-512/224
+  const size_t part_i_words = part_i_size / sizeof(word_t);
+  const size_t part_wg_size = std::min(wg_size, part_leaf_cnt >> 1);
+
+  // kernel, host to device & device to host transfer time of each domain
+  std::vector<sycl::cl_ulong> ts(part_cnt * 3, 0);
+
+  auto merklize_part = [&](size_t p) {
+    sycl::queue& q = qs[p];
+
+    word_t* i_d = static_cast<word_t*>(sycl::malloc_device(part_i_size, q));
+    word_t* o_d = static_cast<word_t*>(sycl::malloc_device(part_o_size, q));
+
+    // first-touch, from this NUMA domain
+    sycl::event evt_0 = q.memset(i_d, 0, part_i_size);
+    sycl::event evt_1 = q.memset(o_d, 0, part_o_size);
+    evt_0.wait();
+    evt_1.wait();
+
+    sycl::event evt_2 =
+      q.memcpy(i_d, leaf_nodes + p * part_i_words, part_i_size);
+    evt_2.wait();
+    ts[p * 3 + 1] = time_event(evt_2);
+
+    ts[p * 3 + 0] = merklize<H>(q,
+                                i_d,
+                                part_i_size,
+                                part_leaf_cnt,
+                                o_d,
+                                part_o_size,
+                                part_leaf_cnt - 1,
+                                part_wg_size);
+
+    // level of subtree, having m -many nodes, at [m, 2m), lands at
+    // [m * (P + p), m * (P + p + 1)) of whole tree
+    std::vector<sycl::event> evts;
+    for (size_t m = part_leaf_cnt >> 1; m > 0; m >>= 1) {
+      evts.push_back(
+        q.memcpy(intermediates + m * (part_cnt + p) * H::NODE_WORDS,
+                 o_d + m * H::NODE_WORDS,
+                 m * H::NODE_LEN_BYTES));
+    }
+
+    for (sycl::event& evt : evts) {
+      evt.wait();
+      ts[p * 3 + 2] += time_event(evt);
+    }
+
+    sycl::free(i_d, q);
+    sycl::free(o_d, q);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(part_cnt - 1);
+
+  for (size_t p = 1; p < part_cnt; p++) {
+    threads.emplace_back(merklize_part, p);
+  }
+
+  // calling thread drives first domain
+  merklize_part(0);
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // merge subtree roots, living at [P, 2P), on host
+  for (size_t i = part_cnt - 1; i > 0; i--) {
+    node::hash_nodes<H>(intermediates + (i << 1) * H::NODE_WORDS,
+                        intermediates + i * H::NODE_WORDS);
+  }
+
+  sycl::cl_ulong k_ts = 0;
+  tx_ts[0] = 0;
+  tx_ts[1] = 0;
+
+  for (size_t p = 0; p < part_cnt; p++) {
+    k_ts = std::max(k_ts, ts[p * 3 + 0]);
+    tx_ts[0] = std::max(tx_ts[0], ts[p * 3 + 1]);
+    tx_ts[1] = std::max(tx_ts[1], ts[p * 3 + 2]);
+  }
+
+  return k_ts;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "merklize.hpp"
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelBinaryMerklizationPersistent;
+
+// Binary merklization, using single kernel dispatch, where each work-item
+// starts by merging two consecutive leaf nodes into an intermediate node and
+// then keeps climbing up the tree, as long as it's the last one ( among two
+// children ) to finish computing its subtree --- for doing so, each
+// intermediate node ( except root ) has a counter, which is atomically
+// incremented by both of its children, once they're computed & written back to
+// global memory
+//
+// The work-item which observes that its sibling is already done, continues
+// computing parent, while the other one exits; meaning, no work-item ever waits
+// for another one, so no assumption regarding forward progress of work-groups
+// is made
+//
+// This removes all kernel dispatches ( and inter-level dependencies ) required
+// for computing upper levels of tree, which are otherwise computed by very
+// narrow kernel dispatches, in `merklize` --- defined in merklize.hpp
+//
+// Output memory layout is same as `merklize`
+template<typename H>
+sycl::cl_ulong
+merklize_persistent(sycl::queue& q,
+                    const typename H::word_t* __restrict leaf_nodes,
+                    size_t i_size, // leaf nodes size in bytes
+                    size_t leaf_cnt,
+                    typename H::word_t* const __restrict intermediates,
+                    size_t o_size, // intermediate nodes size in bytes
+                    size_t itmd_cnt,
+                    size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  // A binary merkle tree with N -many leaf
+  // nodes should have (N - 1) -many intermediates
+  //
+  // Note N = power of 2
+  assert(leaf_cnt == itmd_cnt + 1);
+
+  assert(i_size == (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t));
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+  // N -many leaf nodes to be merged into N/ 2 -many intermediate nodes, by
+  // same many work-items, which are then going to climb up the tree
+  const size_t work_item_cnt = leaf_cnt >> 1;
+
+  // validate whether this work group size can be used for kernel dispatch
+  assert(work_item_cnt % wg_size == 0);
+
+  // one arrival counter for each intermediate node which has children
+  // living on some intermediate level; counter at index `i` is associated with
+  // intermediate node `i`, where index 0 is never used
+  const size_t ctr_size = sizeof(sycl::uint) * work_item_cnt;
+  sycl::uint* ctrs = static_cast<sycl::uint*>(sycl::malloc_device(ctr_size, q));
+
+  sycl::event evt_0 = q.memset(ctrs, 0, ctr_size);
+
+  sycl::event evt_1 = q.submit([&](sycl::handler& h) {
+    h.depends_on(evt_0);
+
+    h.parallel_for<kernelBinaryMerklizationPersistent<H>>(
+      sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                         sycl::range<1>{ wg_size } },
+      [=](sycl::nd_item<1> it) {
+        const size_t idx = it.get_global_linear_id();
+
+        word_t digest[H::NODE_WORDS];
+
+        // intermediate node living just above leaf nodes
+        size_t n_idx = work_item_cnt + idx;
+        node::hash_leaves<H>(leaf_nodes + idx * H::LEAF_PAIR_WORDS, digest);
+
+        while (true) {
+#pragma unroll 8
+          for (size_t i = 0; i < H::NODE_WORDS; i++) {
+            intermediates[n_idx * H::NODE_WORDS + i] = digest[i];
+          }
+
+          // root of tree is just computed
+          if (n_idx == 1) {
+            break;
+          }
+
+          const size_t p_idx = n_idx >> 1;
+
+          // release ordering makes sure that just written node is visible to
+          // sibling work-item, while acquire ordering makes sure that sibling
+          // node is visible to this work-item, if it's the last one to arrive
+          sycl::atomic_ref<sycl::uint,
+                           sycl::memory_order::acq_rel,
+                           sycl::memory_scope::device,
+                           sycl::access::address_space::global_space>
+            ctr{ ctrs[p_idx] };
+
+          // sibling is still being computed, it'll compute parent
+          if (ctr.fetch_add(1u) == 0u) {
+            break;
+          }
+
+          n_idx = p_idx;
+          node::hash_nodes<H>(intermediates + (n_idx << 1) * H::NODE_WORDS,
+                              digest);
+        }
+      });
+  });
+
+  // wait for single kernel dispatch, where all intermediate nodes including
+  // root of binary merkle tree are computed
+  evt_1.wait();
+
+  sycl::free(ctrs, q);
+
+  // return kernel execution cost, in terms of nanosecond
+  return time_event(evt_1);
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Binary merklization, where leaf nodes living on host memory are uploaded to
+// accelerator in `seg_cnt` -many segments ( power of 2 ), each one using its
+// own data transfer command, while first phase of `merklize` is dispatched on
+// each segment as soon as that segment lands, so that leaf node pairs of
+// earlier segments are hashed, while later segments are still in flight
+//
+// Remaining phase of `merklize` starts once first phase of all segments are
+// complete, computing intermediate nodes in exactly same layout as `merklize`
+//
+// `leaf_nodes_h` is host memory ( better overlapping is achieved when it's
+// pinned, allocated using `sycl::malloc_host` ), while `leaf_nodes` &
+// `intermediates` are accelerator memory, where former receives leaf nodes
+//
+// Total host to device data transfer time is written to `tx_ts[0]`, while
+// portion of it which was hidden behind first phase of merklization ( i.e. for
+// each transfer, time during which some first phase kernel was executing ) is
+// written to `tx_ts[1]` ( <= `tx_ts[0]` ), while total kernel execution time is
+// returned, all in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_pipelined(sycl::queue& q,
+                   const typename H::word_t* const leaf_nodes_h,
+                   typename H::word_t* const __restrict leaf_nodes,
+                   size_t i_size, // leaf nodes size in bytes
+                   size_t leaf_cnt,
+                   typename H::word_t* const __restrict intermediates,
+                   size_t o_size, // intermediate nodes size in bytes
+                   size_t itmd_cnt,
+                   size_t wg_size,
+                   size_t seg_cnt,
+                   sycl::cl_ulong* const tx_ts)
+{
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt == itmd_cnt + 1);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(i_size == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  const size_t pair_cnt = leaf_cnt >> 1;
+
+  assert(seg_cnt >= 1);
+  assert((seg_cnt & (seg_cnt - 1)) == 0);
+  assert(seg_cnt <= pair_cnt);
+
+  // each segment holds these many leaf node pairs ( = power of 2 ), so each of
+  // them begins at word boundary, even for SHA2-512/224
+  const size_t seg_pair_cnt = pair_cnt / seg_cnt;
+  const size_t seg_words = seg_pair_cnt * H::LEAF_PAIR_WORDS;
+  const size_t seg_size = i_size / seg_cnt;
+  const size_t wg_size_ = std::min(wg_size, seg_pair_cnt);
+
+  // first phase is dispatched once per segment, while remaining phase is
+  // dispatched once per level of intermediate nodes
+  const size_t rounds =
+    static_cast<size_t>(sycl::log2(static_cast<double>(pair_cnt)));
+
+  std::vector<sycl::event> tx_evts;
+  std::vector<sycl::event> evts;
+  tx_evts.reserve(seg_cnt);
+  evts.reserve(seg_cnt + rounds);
+
+  // all data transfers are enqueued first, so that they're never held back by
+  // kernel dispatches, while each kernel dispatch only waits for its segment
+  for (size_t s = 0; s < seg_cnt; s++) {
+    tx_evts.push_back(q.memcpy(
+      leaf_nodes + s * seg_words, leaf_nodes_h + s * seg_words, seg_size));
+  }
+
+  for (size_t s = 0; s < seg_cnt; s++) {
+    evts.push_back(merklize_phase0<H>(q,
+                                      leaf_nodes,
+                                      leaf_cnt,
+                                      intermediates,
+                                      s * seg_pair_cnt,
+                                      seg_pair_cnt,
+                                      wg_size_,
+                                      { tx_evts.at(s) }));
+  }
+
+  merklize_phase1<H>(q, leaf_cnt, intermediates, wg_size, &evts);
+
+  // wait for last kernel dispatch round, where root of binary merkle tree is
+  // computed !
+  evts.back().wait();
+
+  using interval_t = std::pair<sycl::cl_ulong, sycl::cl_ulong>;
+
+  auto interval_of = [](const sycl::event& evt) -> interval_t {
+    return {
+      evt.get_profiling_info<sycl::info::event_profiling::command_start>(),
+      evt.get_profiling_info<sycl::info::event_profiling::command_end>()
+    };
+  };
+
+  // first phase kernels may overlap each other on out-of-order queue, so they
+  // are merged into disjoint intervals of time, during which some of them was
+  // executing, so that no part of transfer is counted as hidden twice
+  std::vector<interval_t> busy;
+  busy.reserve(seg_cnt);
+  for (size_t s = 0; s < seg_cnt; s++) {
+    busy.push_back(interval_of(evts.at(s)));
+  }
+  std::sort(busy.begin(), busy.end());
+
+  size_t busy_cnt = 0;
+  for (size_t s = 0; s < seg_cnt; s++) {
+    if (busy_cnt > 0 && busy[s].first <= busy[busy_cnt - 1].second) {
+      busy[busy_cnt - 1].second =
+        std::max(busy[busy_cnt - 1].second, busy[s].second);
+    } else {
+      busy[busy_cnt++] = busy[s];
+    }
+  }
+  busy.resize(busy_cnt);
+
+  sycl::cl_ulong tx_ts_ = 0;
+  sycl::cl_ulong hidden_ts = 0;
+
+  for (size_t s = 0; s < seg_cnt; s++) {
+    const interval_t tx = interval_of(tx_evts.at(s));
+    tx_ts_ += tx.second - tx.first;
+
+    for (const interval_t& b : busy) {
+      const sycl::cl_ulong start = std::max(tx.first, b.first);
+      const sycl::cl_ulong end = std::min(tx.second, b.second);
+
+      hidden_ts += end > start ? end - start : 0;
+    }
+  }
+
+  tx_ts[0] = tx_ts_;
+  tx_ts[1] = hidden_ts;
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  sycl::cl_ulong ts = 0;
+  for (size_t r = 0; r < evts.size(); r++) {
+    ts += time_event(evts.at(r));
+  }
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
@@ -0,0 +1,212 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <vector>
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelMerkleProofGather;
+
+// Gathers nodes of binary merkle tree ( with `leaf_cnt` -many leaf nodes,
+// power of 2 ), identified by their implicit heap index, where root lives at
+// node 1, children of node `i` live at node 2i & 2i + 1 and leaf node `j`
+// lives at node (leaf_cnt + j), into NODE_WORDS -many words each, using single
+// kernel dispatch
+//
+// `leaf_nodes` & `intermediates` are accelerator memory, holding leaf nodes
+// ( as pairs ) & intermediate nodes, exactly as passed to/ produced by
+// `merklize`, while `slots` & `out` are host memory; only gathered nodes are
+// transferred back to host
+//
+// Returns kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+gather_nodes(sycl::queue& q,
+             const typename H::word_t* const leaf_nodes,
+             const typename H::word_t* const intermediates,
+             size_t leaf_cnt,
+             const size_t* const slots,
+             size_t slot_cnt,
+             typename H::word_t* const out,
+             size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  if (slot_cnt == 0) {
+    return 0;
+  }
+
+  const size_t slot_size = sizeof(size_t) * slot_cnt;
+  const size_t o_size = H::NODE_LEN_BYTES * slot_cnt;
+
+  size_t* slots_d = static_cast<size_t*>(sycl::malloc_device(slot_size, q));
+  word_t* out_d = static_cast<word_t*>(sycl::malloc_device(o_size, q));
+
+  sycl::event evt_0 = q.memcpy(slots_d, slots, slot_size);
+
+  // global range is rounded up to multiple of work-group size, while surplus
+  // work-items don't do anything
+  const size_t wg_size_ = wg_size <= slot_cnt ? wg_size : slot_cnt;
+  const size_t work_item_cnt =
+    ((slot_cnt + wg_size_ - 1) / wg_size_) * wg_size_;
+
+  sycl::event evt_1 = q.submit([&](sycl::handler& h) {
+    h.depends_on(evt_0);
+
+    h.parallel_for<kernelMerkleProofGather<H>>(
+      sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                         sycl::range<1>{ wg_size_ } },
+      [=](sycl::nd_item<1> it) {
+        const size_t idx = it.get_global_linear_id();
+        if (idx >= slot_cnt) {
+          return;
+        }
+
+        const size_t n_idx = slots_d[idx];
+        word_t* const o = out_d + idx * H::NODE_WORDS;
+
+        if (n_idx >= leaf_cnt) {
+          node::leaf_at<H>(leaf_nodes, n_idx - leaf_cnt, o);
+        } else {
+#pragma unroll 8
+          for (size_t i = 0; i < H::NODE_WORDS; i++) {
+            o[i] = intermediates[n_idx * H::NODE_WORDS + i];
+          }
+        }
+      });
+  });
+
+  q.memcpy(out, out_d, o_size, evt_1).wait();
+
+  sycl::free(slots_d, q);
+  sycl::free(out_d, q);
+
+  return time_event(evt_1);
+}
+
+// Extracts inclusion proofs of `idx_cnt` -many leaf nodes, at index
+// `leaf_idxs[i]`, from binary merkle tree ( with `leaf_cnt` -many leaf nodes,
+// power of 2 ), computed by `merklize`, using single kernel dispatch
+//
+// Inclusion proof of each leaf node is its authentication path i.e. sibling of
+// each node on its path to root ( excluding root ), bottom-up, so each proof is
+// log2(leaf_cnt) -many nodes, NODE_WORDS -many words each; proof of leaf node
+// `leaf_idxs[i]` is written to `proofs + i * log2(leaf_cnt) * NODE_WORDS`,
+// where `proofs` is host memory
+//
+// When bit `l` of leaf index is set, sibling at level `l` is left child of
+// their parent
+//
+// Returns kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merkle_proofs(sycl::queue& q,
+              const typename H::word_t* const leaf_nodes,
+              const typename H::word_t* const intermediates,
+              size_t leaf_cnt,
+              const size_t* const leaf_idxs,
+              size_t idx_cnt,
+              typename H::word_t* const proofs,
+              size_t wg_size)
+{
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+  const size_t depth =
+    static_cast<size_t>(sycl::log2(static_cast<double>(leaf_cnt)));
+
+  std::vector<size_t> slots;
+  slots.reserve(idx_cnt * depth);
+
+  for (size_t i = 0; i < idx_cnt; i++) {
+    assert(leaf_idxs[i] < leaf_cnt);
+
+    for (size_t n_idx = leaf_cnt + leaf_idxs[i]; n_idx > 1; n_idx >>= 1) {
+      slots.push_back(n_idx ^ 1);
+    }
+  }
+
+  return gather_nodes<H>(q,
+                         leaf_nodes,
+                         intermediates,
+                         leaf_cnt,
+                         slots.data(),
+                         slots.size(),
+                         proofs,
+                         wg_size);
+}
+
+// Extracts compact multiproof of `idx_cnt` -many leaf nodes, at index
+// `leaf_idxs[i]`, from binary merkle tree ( with `leaf_cnt` -many leaf nodes,
+// power of 2 ), computed by `merklize`, using single kernel dispatch
+//
+// Unlike concatenating individual inclusion proofs, nodes which can be derived
+// from other requested leaf nodes ( or from other nodes of proof ) are omitted,
+// so each required node appears only once
+//
+// Implicit heap index ( see `gather_nodes` ) of each node of multiproof is
+// written to `slots`, level by level, bottom-up, in ascending order within a
+// level, while NODE_WORDS -many words of respective node are written to
+// `proof`, in same order
+//
+// Returns kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merkle_multiproof(sycl::queue& q,
+                  const typename H::word_t* const leaf_nodes,
+                  const typename H::word_t* const intermediates,
+                  size_t leaf_cnt,
+                  const size_t* const leaf_idxs,
+                  size_t idx_cnt,
+                  std::vector<size_t>* const slots,
+                  std::vector<typename H::word_t>* const proof,
+                  size_t wg_size)
+{
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+  slots->clear();
+  proof->clear();
+
+  if (idx_cnt == 0) {
+    return 0;
+  }
+
+  // nodes which are known ( or derivable ) on current level, sorted
+  std::vector<size_t> known(idx_cnt);
+  for (size_t i = 0; i < idx_cnt; i++) {
+    assert(leaf_idxs[i] < leaf_cnt);
+    known[i] = leaf_cnt + leaf_idxs[i];
+  }
+  std::sort(known.begin(), known.end());
+  known.erase(std::unique(known.begin(), known.end()), known.end());
+
+  while (known.front() > 1) {
+    for (size_t i = 0; i < known.size(); i++) {
+      // sibling is also known, so it's not required in proof
+      if ((known[i] & 1) == 0 && i + 1 < known.size() &&
+          known[i + 1] == known[i] + 1) {
+        i++;
+        continue;
+      }
+
+      slots->push_back(known[i] ^ 1);
+    }
+
+    for (size_t& n_idx : known) {
+      n_idx >>= 1;
+    }
+    known.erase(std::unique(known.begin(), known.end()), known.end());
+  }
+
+  proof->resize(slots->size() * H::NODE_WORDS);
+
+  return gather_nodes<H>(q,
+                         leaf_nodes,
+                         intermediates,
+                         leaf_cnt,
+                         slots->data(),
+                         slots->size(),
+                         proof->data(),
+                         wg_size);
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Binary merklization, where each level of intermediate nodes is copied back
+// to `intermediates_h` ( host memory ) as soon as kernel computing that level
+// completes, while accelerator keeps working on levels above it, so that whole
+// tree is available on host shortly after root is computed, instead of waiting
+// for root and then copying all intermediate nodes back at once
+//
+// Intermediate nodes are computed exactly same way as `merklize` does, on
+// accelerator memory `intermediates`, while `intermediates_h` receives same
+// layout; levels having at max `wg_size` -many nodes are copied back together,
+// after root is computed, as they are too small to be worth separate transfers
+//
+// Total device to host data transfer time is written to `tx_ts[0]`, while
+// portion of it which was hidden behind merklization ( i.e. sum of transfer &
+// kernel execution time, minus wall clock time from first kernel started to
+// last transfer completed ) is written to `tx_ts[1]`, while total kernel
+// execution time is returned, all in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_readback(sycl::queue& q,
+                  const typename H::word_t* __restrict leaf_nodes,
+                  size_t i_size, // leaf nodes size in bytes
+                  size_t leaf_cnt,
+                  typename H::word_t* const __restrict intermediates,
+                  size_t o_size, // intermediate nodes size in bytes
+                  size_t itmd_cnt,
+                  size_t wg_size,
+                  typename H::word_t* const intermediates_h,
+                  sycl::cl_ulong* const tx_ts)
+{
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt == itmd_cnt + 1);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(i_size == leaf_cnt * H::DIGEST_LEN_BYTES);
+  assert(o_size == (itmd_cnt + 1) * H::NODE_LEN_BYTES);
+
+  const size_t pair_cnt = leaf_cnt >> 1;
+
+  assert(wg_size <= pair_cnt);
+  assert(pair_cnt % wg_size == 0);
+
+  // these many kernel dispatch rounds, after first phase
+  const size_t rounds =
+    static_cast<size_t>(sycl::log2(static_cast<double>(pair_cnt)));
+
+  std::vector<sycl::event> evts;
+  evts.reserve(rounds + 1);
+
+  evts.push_back(merklize_phase0<H>(
+    q, leaf_nodes, leaf_cnt, intermediates, 0, pair_cnt, wg_size, {}));
+  merklize_phase1<H>(q, leaf_cnt, intermediates, wg_size, &evts);
+
+  // kernel dispatch `r` computes level living at node index [m, 2m), where m =
+  // pair_cnt >> r, so it's copied back as soon as that dispatch completes
+  std::vector<sycl::event> tx_evts;
+  tx_evts.reserve(rounds + 1);
+
+  size_t r = 0;
+  for (; r <= rounds && (pair_cnt >> r) > wg_size; r++) {
+    const size_t m = pair_cnt >> r;
+
+    tx_evts.push_back(q.memcpy(intermediates_h + m * H::NODE_WORDS,
+                               intermediates + m * H::NODE_WORDS,
+                               m * H::NODE_LEN_BYTES,
+                               evts.at(r)));
+  }
+
+  // remaining levels, living at node index [1, 2m), are copied back together,
+  // after root is computed
+  {
+    const size_t m = pair_cnt >> r;
+
+    tx_evts.push_back(q.memcpy(intermediates_h + H::NODE_WORDS,
+                               intermediates + H::NODE_WORDS,
+                               ((m << 1) - 1) * H::NODE_LEN_BYTES,
+                               evts.back()));
+  }
+
+  for (sycl::event& evt : tx_evts) {
+    evt.wait();
+  }
+
+  sycl::cl_ulong ts = 0;
+  sycl::cl_ulong tx_ts_ = 0;
+  sycl::cl_ulong start = std::numeric_limits<sycl::cl_ulong>::max();
+  sycl::cl_ulong end = 0;
+
+  // time execution of all enqueued kernels with nanosecond level granularity
+  for (sycl::event& evt : evts) {
+    ts += time_event(evt);
+
+    const sycl::cl_ulong start_ =
+      evt.get_profiling_info<sycl::info::event_profiling::command_start>();
+    start = std::min(start, start_);
+  }
+
+  for (sycl::event& evt : tx_evts) {
+    tx_ts_ += time_event(evt);
+
+    const sycl::cl_ulong end_ =
+      evt.get_profiling_info<sycl::info::event_profiling::command_end>();
+    end = std::max(end, end_);
+  }
+
+  // time spent on kernels & transfers, beyond wall clock time it took to
+  // complete all of them, is what was overlapped
+  const sycl::cl_ulong busy = ts + tx_ts_;
+  const sycl::cl_ulong span = end - start;
+
+  tx_ts[0] = tx_ts_;
+  tx_ts[1] = busy > span ? busy - span : 0;
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
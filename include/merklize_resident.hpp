@@ -0,0 +1,255 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <vector>
+
+// Kernel names, one for each hasher policy
+template<typename H>
+class kernelResidentTreeLeaves;
+template<typename H>
+class kernelResidentTreeWriteLeaves;
+template<typename H>
+class kernelResidentTreeUpdate;
+
+// Binary merkle tree ( with power of 2 many leaf nodes ), which stays resident
+// in accelerator memory between calls, so that when only few leaf nodes change,
+// only intermediate nodes on their paths to root are recomputed, instead of
+// merklizing whole tree again, along with full host <-> device data transfers
+//
+// All nodes live in a single accelerator allocation of 2 * leaf_cnt -many
+// nodes, each NODE_WORDS -many words wide, following implicit heap layout,
+// where node 0 is never used, root lives at node 1 and children of node `i`
+// live at node 2i & 2i + 1; intermediate nodes occupy node index [1,
+// leaf_cnt), in same layout as `merklize` produces, while leaf nodes occupy
+// node index [leaf_cnt, 2 * leaf_cnt), each one being placed in its own node
+// slot ( see `node::leaf_to_node` in merklize.hpp )
+template<typename H>
+class resident_tree
+{
+public:
+  using word_t = typename H::word_t;
+
+  // Copies `leaf_cnt` -many leaf nodes ( power of 2 ), living on host memory as
+  // (leaf_cnt / 2) -many pairs of consecutive leaf nodes, just like `merklize`
+  // expects them, to accelerator and merklizes them using `merklize`
+  resident_tree(sycl::queue& q,
+                const word_t* const leaf_nodes,
+                size_t leaf_cnt,
+                size_t wg_size)
+    : q(q)
+    , leaf_cnt(leaf_cnt)
+    , wg_size(wg_size)
+  {
+    // only tree with power of 2 many leaf nodes
+    // can be kept resident
+    assert(leaf_cnt >= 2);
+    assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+
+    const size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+    const size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+    nodes = static_cast<word_t*>(sycl::malloc_device(o_size << 1, q));
+    word_t* i_d = static_cast<word_t*>(sycl::malloc_device(i_size, q));
+
+    q.memcpy(i_d, leaf_nodes, i_size).wait();
+    q.memset(nodes, 0, o_size).wait();
+
+    merklize<H>(q,
+                i_d,
+                i_size,
+                leaf_cnt,
+                nodes,
+                o_size,
+                leaf_cnt - 1,
+                std::min(wg_size, leaf_cnt >> 1));
+
+    // place each leaf node in its own node slot, after intermediate nodes
+    word_t* const nodes_ = nodes;
+    const size_t leaf_cnt_ = leaf_cnt;
+
+    sycl::event evt = q.submit([&](sycl::handler& h) {
+      h.parallel_for<kernelResidentTreeLeaves<H>>(
+        sycl::range<1>{ leaf_cnt_ }, [=](sycl::id<1> id) {
+          const size_t idx = id[0];
+          node::leaf_at<H>(
+            i_d, idx, nodes_ + (leaf_cnt_ + idx) * H::NODE_WORDS);
+        });
+    });
+    evt.wait();
+
+    sycl::free(i_d, q);
+  }
+
+  resident_tree(const resident_tree&) = delete;
+  resident_tree& operator=(const resident_tree&) = delete;
+
+  ~resident_tree() { sycl::free(nodes, q); }
+
+  // Replaces leaf node at index `indices[i]` with `new_leaves[i]` ( NODE_WORDS
+  // -many words ), for all i < cnt, where both of them live on host memory,
+  // and recomputes only those intermediate nodes, which are ancestors of
+  // updated leaf nodes
+  //
+  // Dirty intermediate nodes are collected level by level on host, where
+  // shared ancestors are deduplicated, so that each of them is hashed only
+  // once, while each level is computed by single kernel dispatch; cost of
+  // update is proportional to cnt * log2(leaf_cnt), instead of leaf_cnt
+  //
+  // If same leaf index appears multiple times, last one wins
+  //
+  // Returns total kernel execution time, in nanoseconds
+  sycl::cl_ulong update(const size_t* const indices,
+                        const word_t* const new_leaves,
+                        size_t cnt)
+  {
+    if (cnt == 0) {
+      return 0;
+    }
+
+    // order of updates, sorted by leaf index, while for same leaf index only
+    // last update is kept
+    std::vector<size_t> order(cnt);
+    for (size_t i = 0; i < cnt; i++) {
+      assert(indices[i] < leaf_cnt);
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return indices[a] < indices[b];
+    });
+
+    std::vector<size_t> leaf_idxs;
+    std::vector<word_t> leaves;
+    leaf_idxs.reserve(cnt);
+    leaves.reserve(cnt * H::NODE_WORDS);
+
+    for (size_t i = 0; i < cnt; i++) {
+      if (i + 1 < cnt && indices[order[i]] == indices[order[i + 1]]) {
+        continue;
+      }
+
+      const word_t* leaf = new_leaves + order[i] * H::NODE_WORDS;
+      leaf_idxs.push_back(leaf_cnt + indices[order[i]]);
+      leaves.insert(leaves.end(), leaf, leaf + H::NODE_WORDS);
+    }
+
+    // dirty intermediate nodes, level by level, bottom-up, where level `l`
+    // lives at [lvl_offs[l], lvl_offs[l + 1]) of `dirty`; as leaf indices are
+    // sorted, parents are sorted too, so deduplicating them is cheap
+    std::vector<size_t> dirty;
+    std::vector<size_t> lvl_offs{ 0 };
+
+    {
+      std::vector<size_t> cur = leaf_idxs;
+
+      while (cur.front() > 1) {
+        for (size_t& n_idx : cur) {
+          n_idx >>= 1;
+        }
+        cur.erase(std::unique(cur.begin(), cur.end()), cur.end());
+
+        dirty.insert(dirty.end(), cur.begin(), cur.end());
+        lvl_offs.push_back(dirty.size());
+      }
+    }
+
+    const size_t upd_cnt = leaf_idxs.size();
+    const size_t idx_size = sizeof(size_t) * (upd_cnt + dirty.size());
+    const size_t leaf_size = sizeof(word_t) * leaves.size();
+
+    size_t* idxs_d = static_cast<size_t*>(sycl::malloc_device(idx_size, q));
+    word_t* leaves_d = static_cast<word_t*>(sycl::malloc_device(leaf_size, q));
+
+    sycl::event evt_0 =
+      q.memcpy(idxs_d, leaf_idxs.data(), sizeof(size_t) * upd_cnt);
+    sycl::event evt_1 = q.memcpy(
+      idxs_d + upd_cnt, dirty.data(), sizeof(size_t) * dirty.size());
+    sycl::event evt_2 = q.memcpy(leaves_d, leaves.data(), leaf_size);
+
+    word_t* const nodes_ = nodes;
+
+    // write updated leaf nodes into their node slots
+    sycl::event evt_3 = q.submit([&](sycl::handler& h) {
+      h.depends_on({ evt_0, evt_1, evt_2 });
+
+      h.parallel_for<kernelResidentTreeWriteLeaves<H>>(
+        sycl::range<1>{ upd_cnt }, [=](sycl::id<1> id) {
+          const size_t i = id[0];
+          word_t* const out = nodes_ + idxs_d[i] * H::NODE_WORDS;
+
+#pragma unroll 8
+          for (size_t j = 0; j < H::NODE_WORDS; j++) {
+            out[j] = leaves_d[i * H::NODE_WORDS + j];
+          }
+        });
+    });
+
+    std::vector<sycl::event> evts;
+    evts.reserve(lvl_offs.size());
+    evts.push_back(evt_3);
+
+    for (size_t l = 0; l + 1 < lvl_offs.size(); l++) {
+      const size_t node_cnt = lvl_offs[l + 1] - lvl_offs[l];
+      const size_t* dirty_d = idxs_d + upd_cnt + lvl_offs[l];
+
+      // global range is rounded up to multiple of work-group size, while
+      // surplus work-items don't do anything
+      const size_t wg_size_ = wg_size <= node_cnt ? wg_size : node_cnt;
+      const size_t work_item_cnt =
+        ((node_cnt + wg_size_ - 1) / wg_size_) * wg_size_;
+
+      sycl::event evt = q.submit([&](sycl::handler& h) {
+        // each level depends on previous level being computed
+        h.depends_on(evts.back());
+
+        h.parallel_for<kernelResidentTreeUpdate<H>>(
+          sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                             sycl::range<1>{ wg_size_ } },
+          [=](sycl::nd_item<1> it) {
+            const size_t idx = it.get_global_linear_id();
+            if (idx >= node_cnt) {
+              return;
+            }
+
+            const size_t n_idx = dirty_d[idx];
+            node::hash_nodes<H>(nodes_ + (n_idx << 1) * H::NODE_WORDS,
+                                nodes_ + n_idx * H::NODE_WORDS);
+          });
+      });
+      evts.push_back(evt);
+    }
+
+    // wait for last kernel dispatch, where root is recomputed
+    evts.back().wait();
+
+    sycl::free(idxs_d, q);
+    sycl::free(leaves_d, q);
+
+    // time execution of all enqueued kernels with nanosecond level granularity
+    sycl::cl_ulong ts = 0;
+    for (size_t r = 0; r < evts.size(); r++) {
+      ts += time_event(evts.at(r));
+    }
+
+    // return total kernel execution cost, in terms of nanosecond
+    return ts;
+  }
+
+  // Copies root of tree to NODE_WORDS -many words of `out`, living on host
+  void root(word_t* const out)
+  {
+    q.memcpy(out, nodes + H::NODE_WORDS, H::NODE_LEN_BYTES).wait();
+  }
+
+  // Accelerator memory holding all nodes of tree, in implicit heap layout
+  const word_t* data() const { return nodes; }
+
+  // # -of leaf nodes of tree
+  size_t size() const { return leaf_cnt; }
+
+private:
+  sycl::queue& q;
+  const size_t leaf_cnt;
+  const size_t wg_size;
+
+  word_t* nodes;
+};
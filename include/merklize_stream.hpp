@@ -0,0 +1,151 @@
+#pragma once
+#include "merklize.hpp"
+#include <algorithm>
+#include <vector>
+
+// Computes # -of leaf nodes ( power of 2 ) in each chunk, when merklizing a
+// tree out-of-core using `merklize_stream`, such that two input buffers (
+// double buffering ) and one output buffer of a chunk fit in half of global
+// memory of device, targeted by `q`, while none of those buffers are larger
+// than what device can allocate at once
+template<typename H>
+size_t
+stream_chunk_leaf_cnt(const sycl::queue& q)
+{
+  const sycl::device d = q.get_device();
+
+  const size_t mem_size = static_cast<size_t>(
+    d.get_info<sycl::info::device::global_mem_size>());
+  const size_t max_alloc = static_cast<size_t>(
+    d.get_info<sycl::info::device::max_mem_alloc_size>());
+
+  // bytes of accelerator memory required per leaf node of chunk
+  const size_t per_leaf = 2 * H::DIGEST_LEN_BYTES + H::NODE_LEN_BYTES;
+  const size_t budget = mem_size >> 1;
+
+  size_t cnt = 2;
+  while ((cnt << 1) * per_leaf <= budget &&
+         (cnt << 1) * H::NODE_LEN_BYTES <= max_alloc) {
+    cnt <<= 1;
+  }
+
+  return cnt;
+}
+
+// Out-of-core binary merklization of `leaf_cnt` -many leaf nodes ( power of 2
+// ), living on host memory as (leaf_cnt / 2) -many pairs of consecutive leaf
+// nodes, just like `merklize` expects them, when whole tree may not fit in
+// accelerator memory
+//
+// Leaf nodes are split into chunks of `chunk_leaf_cnt` -many ( power of 2 )
+// leaf nodes, while subtree of each chunk is merklized on accelerator using
+// `merklize`; transfer of next chunk to accelerator is enqueued before current
+// chunk is merklized, so that they can overlap, using two input buffers in
+// round-robin fashion ( better overlapping is achieved when input lives on
+// pinned host memory, allocated using `sycl::malloc_host` )
+//
+// Only root of each chunk is brought back to host, where they are merged into
+// root of whole tree, which is written to NODE_WORDS -many words of `root`,
+// living on host memory; intermediate nodes are not kept around
+//
+// When `chunk_leaf_cnt` is 0, it's chosen using `stream_chunk_leaf_cnt`, based
+// on global memory size of device, while it's never larger than `leaf_cnt`
+//
+// Total host to device & device to host data transfer time is written to
+// `tx_ts[0]` & `tx_ts[1]` respectively, while total kernel execution time is
+// returned, all in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_stream(sycl::queue& q,
+                const typename H::word_t* const leaf_nodes,
+                size_t i_size, // leaf nodes size in bytes
+                size_t leaf_cnt,
+                typename H::word_t* const root,
+                size_t chunk_leaf_cnt,
+                size_t wg_size,
+                sycl::cl_ulong* const tx_ts)
+{
+  using word_t = typename H::word_t;
+
+  // only tree with power of 2 many leaf nodes
+  // can be merklized by this implementation
+  assert(leaf_cnt >= 2);
+  assert((leaf_cnt & (leaf_cnt - 1)) == 0);
+  assert(i_size == (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t));
+
+  if (chunk_leaf_cnt == 0) {
+    chunk_leaf_cnt = stream_chunk_leaf_cnt<H>(q);
+  }
+  chunk_leaf_cnt = std::min(chunk_leaf_cnt, leaf_cnt);
+
+  assert(chunk_leaf_cnt >= 2);
+  assert((chunk_leaf_cnt & (chunk_leaf_cnt - 1)) == 0);
+
+  const size_t chunk_cnt = leaf_cnt / chunk_leaf_cnt;
+  const size_t chunk_i_size = i_size / chunk_cnt;
+  const size_t chunk_o_size = chunk_leaf_cnt * H::NODE_LEN_BYTES;
+  // # -of words of input, per chunk; as chunk has even many leaf nodes, each
+  // chunk begins at word boundary, even for SHA2-512/224
+  const size_t chunk_i_words = chunk_i_size / sizeof(word_t);
+
+  word_t* i_d[2];
+  i_d[0] = static_cast<word_t*>(sycl::malloc_device(chunk_i_size, q));
+  i_d[1] = static_cast<word_t*>(sycl::malloc_device(chunk_i_size, q));
+  word_t* o_d = static_cast<word_t*>(sycl::malloc_device(chunk_o_size, q));
+
+  // roots of all chunks, in order
+  std::vector<word_t> roots(chunk_cnt * H::NODE_WORDS);
+
+  sycl::cl_ulong ts = 0;
+  tx_ts[0] = 0;
+  tx_ts[1] = 0;
+
+  sycl::event evt_0 = q.memcpy(i_d[0], leaf_nodes, chunk_i_size);
+
+  for (size_t c = 0; c < chunk_cnt; c++) {
+    evt_0.wait();
+    tx_ts[0] += time_event(evt_0);
+
+    // enqueue transfer of next chunk, before merklizing current one
+    if (c + 1 < chunk_cnt) {
+      evt_0 = q.memcpy(i_d[(c + 1) & 1],
+                       leaf_nodes + (c + 1) * chunk_i_words,
+                       chunk_i_size);
+    }
+
+    ts += merklize<H>(q,
+                      i_d[c & 1],
+                      chunk_i_size,
+                      chunk_leaf_cnt,
+                      o_d,
+                      chunk_o_size,
+                      chunk_leaf_cnt - 1,
+                      std::min(wg_size, chunk_leaf_cnt >> 1));
+
+    sycl::event evt_1 = q.memcpy(roots.data() + c * H::NODE_WORDS,
+                                 o_d + H::NODE_WORDS,
+                                 H::NODE_LEN_BYTES);
+    evt_1.wait();
+    tx_ts[1] += time_event(evt_1);
+  }
+
+  sycl::free(i_d[0], q);
+  sycl::free(i_d[1], q);
+  sycl::free(o_d, q);
+
+  // merge roots of chunks, level by level, on host, as there're only few of
+  // them, where nodes of each level replace first half of previous level
+  for (size_t n = chunk_cnt; n > 1; n >>= 1) {
+    for (size_t i = 0; i < (n >> 1); i++) {
+      word_t out[H::NODE_WORDS];
+
+      node::hash_nodes<H>(roots.data() + (i << 1) * H::NODE_WORDS, out);
+      std::copy(out, out + H::NODE_WORDS, roots.begin() + i * H::NODE_WORDS);
+    }
+  }
+
+  std::copy(roots.begin(), roots.begin() + H::NODE_WORDS, root);
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
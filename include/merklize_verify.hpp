@@ -0,0 +1,108 @@
+#pragma once
+#include "merklize.hpp"
+
+// Kernel name, one for each hasher policy
+template<typename H>
+class kernelMerkleProofVerify;
+
+// Verifies `cnt` -many inclusion proofs in parallel, where proof `i` claims
+// that leaf node `leaves[i]` ( NODE_WORDS -many words ) lives at leaf index
+// `leaf_idxs[i]` of binary merkle tree having root `roots[i]` ( NODE_WORDS
+// -many words ), using authentication path of `depth` -many nodes, living at
+// `proofs + i * depth * NODE_WORDS`, in same layout as `merkle_proofs` (
+// defined in merklize_proof.hpp ) produces
+//
+// Each work-item recomputes root from leaf node & authentication path of one
+// proof, using same 2-to-1 hash function as merklization does, and compares
+// it against expected root; result of proof `i` is written to bit (i % 32) of
+// 32 -bit word `bitmap[i / 32]`, where set bit denotes success
+//
+// All of `leaves`, `leaf_idxs`, `proofs`, `roots` & `bitmap` must be
+// accessible from accelerator ( USM ), while `bitmap` must be able to hold
+// ceil(cnt / 32) -many words, which are cleared before verification
+//
+// Returns kernel execution time, in nanoseconds
+template<typename H>
+sycl::cl_ulong
+verify_proofs(sycl::queue& q,
+              const typename H::word_t* const leaves,
+              const size_t* const leaf_idxs,
+              const typename H::word_t* const proofs,
+              const typename H::word_t* const roots,
+              size_t cnt,
+              size_t depth,
+              sycl::uint* const bitmap,
+              size_t wg_size)
+{
+  using word_t = typename H::word_t;
+
+  if (cnt == 0) {
+    return 0;
+  }
+
+  const size_t bm_size = sizeof(sycl::uint) * ((cnt + 31) >> 5);
+  sycl::event evt_0 = q.memset(bitmap, 0, bm_size);
+
+  // global range is rounded up to multiple of work-group size, while surplus
+  // work-items don't do anything
+  const size_t wg_size_ = wg_size <= cnt ? wg_size : cnt;
+  const size_t work_item_cnt = ((cnt + wg_size_ - 1) / wg_size_) * wg_size_;
+
+  sycl::event evt_1 = q.submit([&](sycl::handler& h) {
+    h.depends_on(evt_0);
+
+    h.parallel_for<kernelMerkleProofVerify<H>>(
+      sycl::nd_range<1>{ sycl::range<1>{ work_item_cnt },
+                         sycl::range<1>{ wg_size_ } },
+      [=](sycl::nd_item<1> it) {
+        const size_t idx = it.get_global_linear_id();
+        if (idx >= cnt) {
+          return;
+        }
+
+        const word_t* proof = proofs + idx * depth * H::NODE_WORDS;
+        const size_t leaf_idx = leaf_idxs[idx];
+
+        // first half holds left child, while second half holds right child
+        word_t in_words[H::NODE_WORDS << 1];
+        word_t acc[H::NODE_WORDS];
+
+#pragma unroll 8
+        for (size_t i = 0; i < H::NODE_WORDS; i++) {
+          acc[i] = leaves[idx * H::NODE_WORDS + i];
+        }
+
+        for (size_t l = 0; l < depth; l++) {
+          // when bit `l` of leaf index is set, sibling is left child
+          const size_t acc_off = ((leaf_idx >> l) & 1) * H::NODE_WORDS;
+          const size_t sib_off = H::NODE_WORDS - acc_off;
+
+#pragma unroll 8
+          for (size_t i = 0; i < H::NODE_WORDS; i++) {
+            in_words[acc_off + i] = acc[i];
+            in_words[sib_off + i] = proof[l * H::NODE_WORDS + i];
+          }
+
+          node::hash_nodes<H>(in_words, acc);
+        }
+
+        // leaf index must fit in tree of given depth
+        const bool ok = (leaf_idx >> depth) == 0 &&
+                        node::equal<H>(acc, roots + idx * H::NODE_WORDS);
+
+        if (ok) {
+          sycl::atomic_ref<sycl::uint,
+                           sycl::memory_order::relaxed,
+                           sycl::memory_scope::device,
+                           sycl::access::address_space::global_space>
+            word{ bitmap[idx >> 5] };
+          word.fetch_or(1u << (idx & 31));
+        }
+      });
+  });
+
+  evt_1.wait();
+
+  // return kernel execution cost, in terms of nanosecond
+  return time_event(evt_1);
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "merklize.hpp"
+
+// Kind of memory, leaf nodes passed to `merklize_zero_copy` live on
+enum class leaf_input
+{
+  device,   // `sycl::malloc_device`
+  shared,   // `sycl::malloc_shared`
+  host,     // `sycl::malloc_host`
+  pageable, // system allocator i.e. `std::malloc`, `new`, `std::vector` etc.
+};
+
+// Finds out kind of memory `ptr` points to, as seen from context of `q`
+inline leaf_input
+leaf_input_of(const sycl::queue& q, const void* const ptr)
+{
+  switch (sycl::get_pointer_type(ptr, q.get_context())) {
+    case sycl::usm::alloc::device:
+      return leaf_input::device;
+    case sycl::usm::alloc::shared:
+      return leaf_input::shared;
+    case sycl::usm::alloc::host:
+      return leaf_input::host;
+    default:
+      return leaf_input::pageable;
+  }
+}
+
+// Checks whether kernels dispatched on `q` can read leaf nodes living on `src`
+// kind of memory in place, without first copying them to accelerator memory
+//
+// Device & shared USM are always read in place, while host USM is read in place
+// only when device shares physical memory with host ( i.e. it's CPU ), as
+// otherwise each access crosses interconnect; pageable memory can be read in
+// place only when device supports system allocations
+inline bool
+reads_in_place(const sycl::queue& q, leaf_input src)
+{
+  const sycl::device d = q.get_device();
+
+  switch (src) {
+    case leaf_input::host:
+      return d.is_cpu();
+    case leaf_input::pageable:
+      return d.has(sycl::aspect::usm_system_allocations);
+    default:
+      return true;
+  }
+}
+
+// Binary merklization, where leaf nodes may live on any kind of memory ( see
+// `leaf_input` ), which is found out at run-time, while they're read in place
+// by first phase of `merklize`, whenever `reads_in_place` says so
+//
+// When device is host CPU, copying leaf nodes to accelerator memory only moves
+// them around within same DRAM, so skipping that copy saves whole host to
+// device data transfer; otherwise leaf nodes are staged on a temporary
+// accelerator memory allocation, just like caller would have done
+//
+// Intermediate nodes are written to `intermediates`, living on accelerator
+// memory, in exactly same layout as `merklize` produces
+//
+// Host to device data transfer time, spent on staging leaf nodes ( = 0, when
+// read in place ), is written to `tx_ts[0]`, while total kernel execution time
+// is returned, both in nanoseconds
+template<typename H>
+sycl::cl_ulong
+merklize_zero_copy(sycl::queue& q,
+                   const typename H::word_t* __restrict leaf_nodes,
+                   size_t i_size, // leaf nodes size in bytes
+                   size_t leaf_cnt,
+                   typename H::word_t* const __restrict intermediates,
+                   size_t o_size, // intermediate nodes size in bytes
+                   size_t itmd_cnt,
+                   size_t wg_size,
+                   sycl::cl_ulong* const tx_ts)
+{
+  using word_t = typename H::word_t;
+
+  tx_ts[0] = 0;
+
+  if (reads_in_place(q, leaf_input_of(q, leaf_nodes))) {
+    return merklize<H>(q,
+                       leaf_nodes,
+                       i_size,
+                       leaf_cnt,
+                       intermediates,
+                       o_size,
+                       itmd_cnt,
+                       wg_size);
+  }
+
+  word_t* i_d = static_cast<word_t*>(sycl::malloc_device(i_size, q));
+  assert(i_d != nullptr);
+
+  sycl::event evt = q.memcpy(i_d, leaf_nodes, i_size);
+  evt.wait();
+  tx_ts[0] = time_event(evt);
+
+  const sycl::cl_ulong ts = merklize<H>(
+    q, i_d, i_size, leaf_cnt, intermediates, o_size, itmd_cnt, wg_size);
+
+  sycl::free(i_d, q);
+
+  // return total kernel execution cost, in terms of nanosecond
+  return ts;
+}
@@ -188,6 +188,25 @@ words_to_be_bytes(const sycl::uint* __restrict in,
   }
 }
 
+// Given first sixteen message schedules are already in place, prepares
+// remaining sixty four 32 -bit words of SHA1 message schedule, in-place
+//
+// See step 1 of algorithm defined in section 6.1.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+expand_message_schedule(sycl::uint* const w)
+{
+  // total 64 iteration rounds to be executed, attempting to partially
+  // unroll
+#pragma unroll 16
+  for (size_t i = 16; i < 80; i++) {
+    const sycl::uint tmp0 = *(w + (i - 3)) ^ *(w + (i - 8));
+    const sycl::uint tmp1 = *(w + (i - 14)) ^ *(w + (i - 16));
+
+    *(w + i) = rotl(tmp0 ^ tmp1, 1);
+  }
+}
+
 // Given sixteen 32 -bit words as input to SHA1 hash function
 // prepares eighty 32 -bit words ( as message consumption schedule ) which are
 // consumed into hash state
@@ -204,29 +223,18 @@ prepare_message_schedule(const sycl::uint* __restrict in,
     *(out + i) = *(in + i);
   }
 
-  // total 64 iteration rounds to be executed, attempting to partially
-  // unroll
-#pragma unroll 16
-  for (size_t i = 16; i < 80; i++) {
-    const sycl::uint tmp0 = *(out + (i - 3)) ^ *(out + (i - 8));
-    const sycl::uint tmp1 = *(out + (i - 14)) ^ *(out + (i - 16));
-
-    *(out + i) = rotl(tmp0 ^ tmp1, 1);
-  }
+  expand_message_schedule(out);
 }
 
-// This function takes a padded & parsed message block ( 512 -bit ) as input and
-// produces 160 -bit SHA1 digest i.e. it computes 2-to-1 hash, which is useful
-// during binary merklization
+// Consumes prepared message schedule ( eighty 32 -bit words ) into initial hash
+// state, producing 160 -bit SHA1 digest of single message block
 //
-// See section 6.1.2 of Secure Hash Standard
-// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+// See steps 2 to 4 of algorithm defined in section 6.1.2 of Secure Hash
+// Standard http://dx.doi.org/10.6028/NIST.FIPS.180-4
 void
-hash(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
+hash_schedule(const sycl::uint* __restrict msg_schld,
+              sycl::uint* const __restrict digest)
 {
-  sycl::uint msg_schld[80];
-  prepare_message_schedule(in, msg_schld);
-
   // initialize working variables with initial hash state values
   sycl::uint a = IV_0[0];
   sycl::uint b = IV_0[1];
@@ -282,4 +290,116 @@ hash(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
   *(digest + 4) = IV_0[4] + e;
 }
 
+// This function takes a padded & parsed message block ( 512 -bit ) as input and
+// produces 160 -bit SHA1 digest i.e. it computes 2-to-1 hash, which is useful
+// during binary merklization
+//
+// See section 6.1.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
+{
+  sycl::uint msg_schld[80];
+  prepare_message_schedule(in, msg_schld);
+  hash_schedule(msg_schld, digest);
+}
+
+// 2-to-1 hash function, which takes two concatenated SHA1 digests ( ten 32 -bit
+// words ), reading them straight from `in`, without padding them into separate
+// buffer first, as padding words are compile-time constants, producing 160
+// -bit SHA1 digest
+//
+// See section 5.1.1 & 6.1.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_node(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
+{
+  sycl::uint msg_schld[80];
+
+#pragma unroll 16
+  for (size_t i = 0; i < 16; i++) {
+    msg_schld[i] = i < 10 ? in[i] : node_padding_word<sycl::uint>(10, i);
+  }
+
+  expand_message_schedule(msg_schld);
+  hash_schedule(msg_schld, digest);
+}
+
+// Consumes one padded & parsed message block ( sixteen 32 -bit words ) into
+// SHA1 hash state ( five 32 -bit words ), updating it in-place
+//
+// See section 6.1.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+compress(const sycl::uint* __restrict in, sycl::uint* const __restrict state)
+{
+  sycl::uint msg_schld[80];
+  prepare_message_schedule(in, msg_schld);
+
+  sycl::uint a = state[0];
+  sycl::uint b = state[1];
+  sycl::uint c = state[2];
+  sycl::uint d = state[3];
+  sycl::uint e = state[4];
+
+  for (size_t i = 0; i < 80; i++) {
+    sycl::uint f, k;
+
+    if (i < 20) {
+      f = ch(b, c, d);
+      k = K_0;
+    } else if (i < 40) {
+      f = parity(b, c, d);
+      k = K_1;
+    } else if (i < 60) {
+      f = maj(b, c, d);
+      k = K_2;
+    } else {
+      f = parity(b, c, d);
+      k = K_3;
+    }
+
+    sycl::uint tmp = rotl(a, 5) + f + e + k + msg_schld[i];
+    e = d;
+    d = c;
+    c = rotl(b, 30);
+    b = a;
+    a = tmp;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+// Computes 160 -bit SHA1 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function; message is padded as
+// specified in section 5.1.1 of Secure Hash Standard, while digest is written
+// as five 32 -bit words
+//
+// See section 6.1.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uint* const __restrict digest)
+{
+  sycl::uint state[5];
+
+#pragma unroll 5
+  for (size_t i = 0; i < 5; i++) {
+    state[i] = IV_0[i];
+  }
+
+  for_each_padded_block<sycl::uint, 64, 8>(
+    msg, len, [&](const sycl::uint* blk) { compress(blk, state); });
+
+#pragma unroll 5
+  for (size_t i = 0; i < 5; i++) {
+    digest[i] = state[i];
+  }
+}
+
 }
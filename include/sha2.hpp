@@ -1,6 +1,8 @@
 #pragma once
 #include "utils.hpp"
 #include <CL/sycl.hpp>
+#include <array>
+#include <utility>
 
 // Holds SHA2 specific common functions, which are used by both
 // 32 -bit and 64 -bit word-size variants, in seperate namespaces
@@ -38,7 +40,7 @@ constexpr sycl::uint K[64] = {
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
 //
 // Same function is also used in SHA1
-inline sycl::uint
+constexpr sycl::uint
 ch(sycl::uint x, sycl::uint y, sycl::uint z)
 {
   return (x & y) ^ (~x & z);
@@ -48,7 +50,7 @@ ch(sycl::uint x, sycl::uint y, sycl::uint z)
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
 //
 // Same function is also used in SHA1
-inline sycl::uint
+constexpr sycl::uint
 maj(sycl::uint x, sycl::uint y, sycl::uint z)
 {
   return (x & y) ^ (x & z) ^ (y & z);
@@ -56,7 +58,7 @@ maj(sycl::uint x, sycl::uint y, sycl::uint z)
 
 // SHA2-{224,256} function, defined in section 4.1.2 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::uint
+constexpr sycl::uint
 Σ_0(sycl::uint x)
 {
   return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
@@ -64,7 +66,7 @@ inline sycl::uint
 
 // SHA2-{224,256} function, defined in section 4.1.2 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::uint
+constexpr sycl::uint
 Σ_1(sycl::uint x)
 {
   return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
@@ -72,7 +74,7 @@ inline sycl::uint
 
 // SHA2-{224,256} function, defined in section 4.1.2 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::uint
+constexpr sycl::uint
 σ_0(sycl::uint x)
 {
   return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
@@ -80,12 +82,30 @@ inline sycl::uint
 
 // SHA2-{224,256} function, defined in section 4.1.2 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::uint
+constexpr sycl::uint
 σ_1(sycl::uint x)
 {
   return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
 }
 
+// Given first 16 message schedules are already in place, prepares remaining
+// 48 message schedules, in-place, when using SHA2-{224,256}
+//
+// See step 1 of algorithm defined in section 6.2.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+constexpr void
+expand_message_schedule(sycl::uint* const w)
+{
+  // 48 iteration rounds, preparing 48 remaining message schedules
+#pragma unroll 16
+  for (size_t i = 16; i < 64; i++) {
+    const sycl::uint tmp0 = σ_1(*(w + (i - 2))) + *(w + (i - 7));
+    const sycl::uint tmp1 = σ_0(*(w + (i - 15))) + *(w + (i - 16));
+
+    *(w + i) = tmp0 + tmp1;
+  }
+}
+
 // Given 512 -bit input message block, it prepares 64 message schedules
 // for consuming input message into hash state, when using SHA2-{224,256}
 //
@@ -102,16 +122,315 @@ prepare_message_schedule(const sycl::uint* __restrict in,
     *(out + i) = *(in + i);
   }
 
-  // 48 iteration rounds, preparing 48 remaining message schedules
+  expand_message_schedule(out);
+}
+
+// Consumes one padded & parsed message block ( sixteen 32 -bit words ) into
+// SHA2-{224,256} hash state ( eight 32 -bit words ), updating it in-place
+//
+// See steps 1 to 4 of algorithm defined in section 6.2.2 of Secure Hash
+// Standard http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+compress(const sycl::uint* __restrict in, sycl::uint* const __restrict state)
+{
+  sycl::uint msg_schld[64];
+  prepare_message_schedule(in, msg_schld);
+
+  sycl::uint a = state[0];
+  sycl::uint b = state[1];
+  sycl::uint c = state[2];
+  sycl::uint d = state[3];
+  sycl::uint e = state[4];
+  sycl::uint f = state[5];
+  sycl::uint g = state[6];
+  sycl::uint h = state[7];
+
+  for (size_t t = 0; t < 64; t++) {
+    sycl::uint tmp0 = h + Σ_1(e) + ch(e, f, g) + K[t] + msg_schld[t];
+    sycl::uint tmp1 = Σ_0(a) + maj(a, b, c);
+    h = g;
+    g = f;
+    f = e;
+    e = d + tmp0;
+    d = c;
+    c = b;
+    b = a;
+    a = tmp0 + tmp1;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// Runs 64 rounds of SHA2-{224,256} compression, consuming prepared message
+// schedule `w` into hash state, updating it in-place; when `K_ADDED` is set,
+// round constants are already added to message schedule words
+//
+// Only first `OUT_WORDS` -many words of hash state are updated at end, as
+// truncated digests never emit remaining ones
+//
+// See steps 2 to 4 of algorithm defined in section 6.2.2 of Secure Hash
+// Standard http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t OUT_WORDS, bool K_ADDED>
+inline void
+compress_schedule(const sycl::uint* __restrict w,
+                  sycl::uint* const __restrict state)
+{
+  sycl::uint a = state[0];
+  sycl::uint b = state[1];
+  sycl::uint c = state[2];
+  sycl::uint d = state[3];
+  sycl::uint e = state[4];
+  sycl::uint f = state[5];
+  sycl::uint g = state[6];
+  sycl::uint h = state[7];
+
+  for (size_t t = 0; t < 64; t++) {
+    sycl::uint tmp0 = h + Σ_1(e) + ch(e, f, g) + w[t];
+    if constexpr (!K_ADDED) {
+      tmp0 += K[t];
+    }
+    sycl::uint tmp1 = Σ_0(a) + maj(a, b, c);
+    h = g;
+    g = f;
+    f = e;
+    e = d + tmp0;
+    d = c;
+    c = b;
+    b = a;
+    a = tmp0 + tmp1;
+  }
+
+  const sycl::uint tmp[8] = { a, b, c, d, e, f, g, h };
+
+#pragma unroll
+  for (size_t i = 0; i < OUT_WORDS; i++) {
+    state[i] += tmp[i];
+  }
+}
+
+// Message schedule of second message block, when hashing `MSG_WORDS` -many
+// message words ( two concatenated digests ), where round constants are
+// already added to each message schedule word; as second block only carries
+// padding, it's same for all inputs, so it's computed at compile-time
+template<size_t MSG_WORDS>
+constexpr std::array<sycl::uint, 64>
+padding_block_schedule()
+{
+  std::array<sycl::uint, 64> w{};
+
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = node_padding_word<sycl::uint>(MSG_WORDS, 16 + i);
+  }
+
+  expand_message_schedule(w.data());
+
+  for (size_t i = 0; i < 64; i++) {
+    w[i] += K[i];
+  }
+
+  return w;
+}
+
+template<size_t MSG_WORDS>
+constexpr std::array<sycl::uint, 64> PADDING_BLOCK_WK =
+  padding_block_schedule<MSG_WORDS>();
+
+// SHA2-{224,256} 2-to-1 hash function, computing digest of `MSG_WORDS` -many
+// message words ( two concatenated digests ), which are read straight from
+// `in`, without padding them into separate buffer first, starting from initial
+// hash state `iv`
+//
+// Padding words are compile-time constants, while message schedule of second
+// message block ( if any ), which only carries padding, is taken from
+// `PADDING_BLOCK_WK`; only first `OUT_WORDS` -many words of final hash state
+// are computed & written to `digest`
+//
+// See section 5.1.1 & 6.2.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t MSG_WORDS, size_t OUT_WORDS>
+inline void
+hash_node(const sycl::uint* __restrict iv,
+          const sycl::uint* __restrict in,
+          sycl::uint* const __restrict digest)
+{
+  sycl::uint msg_schld[64];
+  sycl::uint state[8];
+
 #pragma unroll 16
-  for (size_t i = 16; i < 64; i++) {
-    const sycl::uint tmp0 = σ_1(*(out + (i - 2))) + *(out + (i - 7));
-    const sycl::uint tmp1 = σ_0(*(out + (i - 15))) + *(out + (i - 16));
+  for (size_t i = 0; i < 16; i++) {
+    msg_schld[i] =
+      i < MSG_WORDS ? in[i] : node_padding_word<sycl::uint>(MSG_WORDS, i);
+  }
+
+  expand_message_schedule(msg_schld);
 
-    *(out + i) = tmp0 + tmp1;
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = iv[i];
+  }
+
+  if constexpr (node_block_cnt(MSG_WORDS) == 1) {
+    compress_schedule<OUT_WORDS, false>(msg_schld, state);
+  } else {
+    compress_schedule<8, false>(msg_schld, state);
+    compress_schedule<OUT_WORDS, true>(PADDING_BLOCK_WK<MSG_WORDS>.data(),
+                                       state);
+  }
+
+#pragma unroll
+  for (size_t i = 0; i < OUT_WORDS; i++) {
+    digest[i] = state[i];
   }
 }
 
+// One round of SHA2-{224,256} compression, at compile-time known round index
+// `t`, consuming `wk` ( message schedule word, added with round constant ) into
+// hash state `s`
+//
+// Working variables are not shifted after each round, rather each round finds
+// them at rotated indices of `s`, where new `a` & `e` overwrite old `h` & `d`;
+// as `t` is known at compile-time, so are all indices, letting whole hash state
+// live in registers
+//
+// See step 3 of algorithm defined in section 6.2.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t t>
+static inline void
+rnd_step(sycl::uint* const s, const sycl::uint wk)
+{
+  constexpr size_t a = (8 - (t & 7)) & 7;
+  constexpr size_t b = (a + 1) & 7;
+  constexpr size_t c = (a + 2) & 7;
+  constexpr size_t d = (a + 3) & 7;
+  constexpr size_t e = (a + 4) & 7;
+  constexpr size_t f = (a + 5) & 7;
+  constexpr size_t g = (a + 6) & 7;
+  constexpr size_t h = (a + 7) & 7;
+
+  const sycl::uint tmp0 = s[h] + Σ_1(s[e]) + ch(s[e], s[f], s[g]) + wk;
+  const sycl::uint tmp1 = Σ_0(s[a]) + maj(s[a], s[b], s[c]);
+
+  s[d] += tmp0;
+  s[h] = tmp0 + tmp1;
+}
+
+// Round `t` of SHA2-{224,256} compression, where message schedule word is
+// computed in-place, in 16 -word circular window `w`, right before it's
+// consumed, while round constant `K[t]` is an immediate; so that all 64 message
+// schedule words are never materialized at once
+//
+// See step 1 & 3 of algorithm defined in section 6.2.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t t>
+static inline void
+rolling_rnd(sycl::uint* const s, sycl::uint* const w)
+{
+  if constexpr (t >= 16) {
+    w[t & 15] += σ_1(w[(t - 2) & 15]) + w[(t - 7) & 15] + σ_0(w[(t - 15) & 15]);
+  }
+
+  constexpr sycl::uint k = K[t];
+  rnd_step<t>(s, k + w[t & 15]);
+}
+
+template<size_t... t>
+static inline void
+rolling_rnds(sycl::uint* const s,
+             sycl::uint* const w,
+             std::index_sequence<t...>)
+{
+  (rolling_rnd<t>(s, w), ...);
+}
+
+template<size_t MSG_WORDS, size_t... t>
+static inline void
+padding_rnds(sycl::uint* const s, std::index_sequence<t...>)
+{
+  (rnd_step<t>(s, PADDING_BLOCK_WK<MSG_WORDS>[t]), ...);
+}
+
+// Register-lean alternative to `hash_node`, computing same digest, where rounds
+// are fully unrolled at compile-time, while message schedule is computed in a
+// 16 -word circular window, interleaved with rounds ( see `rolling_rnd` ),
+// instead of being materialized as 64 -word array, which otherwise inflates
+// private memory usage of each work-item
+//
+// Second message block ( if any ), which only carries padding, consumes
+// `PADDING_BLOCK_WK`, whose words are immediates too
+template<size_t MSG_WORDS, size_t OUT_WORDS>
+inline void
+hash_node_rolling(const sycl::uint* __restrict iv,
+                  const sycl::uint* __restrict in,
+                  sycl::uint* const __restrict digest)
+{
+  sycl::uint w[16];
+  sycl::uint s[8];
+
+#pragma unroll 16
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = i < MSG_WORDS ? in[i] : node_padding_word<sycl::uint>(MSG_WORDS, i);
+  }
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    s[i] = iv[i];
+  }
+
+  rolling_rnds(s, w, std::make_index_sequence<64>{});
+
+  if constexpr (node_block_cnt(MSG_WORDS) == 2) {
+    sycl::uint mid[8];
+
+#pragma unroll 8
+    for (size_t i = 0; i < 8; i++) {
+      mid[i] = s[i] + iv[i];
+      s[i] = mid[i];
+    }
+
+    padding_rnds<MSG_WORDS>(s, std::make_index_sequence<64>{});
+
+#pragma unroll
+    for (size_t i = 0; i < OUT_WORDS; i++) {
+      digest[i] = s[i] + mid[i];
+    }
+  } else {
+#pragma unroll
+    for (size_t i = 0; i < OUT_WORDS; i++) {
+      digest[i] = s[i] + iv[i];
+    }
+  }
+}
+
+// Computes SHA2-{224,256} hash state after consuming `len` -bytes message,
+// which can be of arbitrary length, starting from initial hash state `iv`;
+// message is padded as specified in section 5.1.1 of Secure Hash Standard,
+// while all eight words of final hash state are written to `state`, which is
+// to be truncated by caller
+//
+// See section 6.2.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::uint* __restrict iv,
+             const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uint* const __restrict state)
+{
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = iv[i];
+  }
+
+  for_each_padded_block<sycl::uint, 64, 8>(
+    msg, len, [&](const sycl::uint* blk) { compress(blk, state); });
+}
+
 }
 
 // Holds common functions/ constants of SHA2 family hash functions
@@ -166,7 +485,7 @@ constexpr sycl::ulong K[80] = {
 //
 // See section 4.1.3 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 ch(sycl::ulong x, sycl::ulong y, sycl::ulong z)
 {
   return (x & y) ^ (~x & z);
@@ -177,7 +496,7 @@ ch(sycl::ulong x, sycl::ulong y, sycl::ulong z)
 //
 // See section 4.1.3 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 maj(sycl::ulong x, sycl::ulong y, sycl::ulong z)
 {
   return (x & y) ^ (x & z) ^ (y & z);
@@ -188,7 +507,7 @@ maj(sycl::ulong x, sycl::ulong y, sycl::ulong z)
 //
 // See section 4.1.3 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 Σ_0(sycl::ulong x)
 {
   return rotr(x, 28) ^ rotr(x, 34) ^ rotr(x, 39);
@@ -199,7 +518,7 @@ inline sycl::ulong
 //
 // See section 4.1.3 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 Σ_1(sycl::ulong x)
 {
   return rotr(x, 14) ^ rotr(x, 18) ^ rotr(x, 41);
@@ -210,7 +529,7 @@ inline sycl::ulong
 //
 // See section 4.1.3 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 σ_0(sycl::ulong x)
 {
   return rotr(x, 1) ^ rotr(x, 8) ^ (x >> 7);
@@ -221,12 +540,29 @@ inline sycl::ulong
 //
 // See section 4.1.3 of Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 σ_1(sycl::ulong x)
 {
   return rotr(x, 19) ^ rotr(x, 61) ^ (x >> 6);
 }
 
+// Given first 16 message schedules are already in place, prepares remaining
+// 64 message schedules, in-place, when using SHA2-{384,512,512/224,512/256}
+//
+// See step 1 of algorithm defined in section 6.4.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+constexpr void
+expand_message_schedule(sycl::ulong* const w)
+{
+#pragma unroll 4
+  for (size_t i = 16; i < 80; i++) {
+    const sycl::ulong tmp0 = σ_1(*(w + (i - 2))) + *(w + (i - 7));
+    const sycl::ulong tmp1 = σ_0(*(w + (i - 15))) + *(w + (i - 16));
+
+    *(w + i) = tmp0 + tmp1;
+  }
+}
+
 // From sixteen message words ( = 64 -bit ) in a mesage block, prepares message
 // schedule of 80 message words, for mixing into hash state
 //
@@ -241,13 +577,316 @@ prepare_message_schedule(const sycl::ulong* __restrict in,
     *(out + i) = *(in + i);
   }
 
-#pragma unroll 4
-  for (size_t i = 16; i < 80; i++) {
-    const sycl::ulong tmp0 = σ_1(*(out + (i - 2))) + *(out + (i - 7));
-    const sycl::ulong tmp1 = σ_0(*(out + (i - 15))) + *(out + (i - 16));
+  expand_message_schedule(out);
+}
+
+// Consumes one padded & parsed message block ( sixteen 64 -bit words ) into
+// SHA2-{384,512,512/224,512/256} hash state ( eight 64 -bit words ), updating
+// it in-place
+//
+// See steps 1 to 4 of algorithm defined in section 6.4.2 of Secure Hash
+// Standard http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+compress(const sycl::ulong* __restrict in, sycl::ulong* const __restrict state)
+{
+  sycl::ulong msg_schld[80];
+  prepare_message_schedule(in, msg_schld);
+
+  sycl::ulong a = state[0];
+  sycl::ulong b = state[1];
+  sycl::ulong c = state[2];
+  sycl::ulong d = state[3];
+  sycl::ulong e = state[4];
+  sycl::ulong f = state[5];
+  sycl::ulong g = state[6];
+  sycl::ulong h = state[7];
+
+  for (size_t t = 0; t < 80; t++) {
+    sycl::ulong tmp0 = h + Σ_1(e) + ch(e, f, g) + K[t] + msg_schld[t];
+    sycl::ulong tmp1 = Σ_0(a) + maj(a, b, c);
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + tmp0;
+    d = c;
+    c = b;
+    b = a;
+    a = tmp0 + tmp1;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// Runs 80 rounds of SHA2-{384,512,512/224,512/256} compression, consuming
+// prepared message schedule `w` into hash state, updating it in-place; when
+// `K_ADDED` is set, round constants are already added to message schedule words
+//
+// Only first `OUT_WORDS` -many words of hash state are updated at end, as
+// truncated digests never emit remaining ones
+//
+// See steps 2 to 4 of algorithm defined in section 6.4.2 of Secure Hash
+// Standard http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t OUT_WORDS, bool K_ADDED>
+inline void
+compress_schedule(const sycl::ulong* __restrict w,
+                  sycl::ulong* const __restrict state)
+{
+  sycl::ulong a = state[0];
+  sycl::ulong b = state[1];
+  sycl::ulong c = state[2];
+  sycl::ulong d = state[3];
+  sycl::ulong e = state[4];
+  sycl::ulong f = state[5];
+  sycl::ulong g = state[6];
+  sycl::ulong h = state[7];
+
+  for (size_t t = 0; t < 80; t++) {
+    sycl::ulong tmp0 = h + Σ_1(e) + ch(e, f, g) + w[t];
+    if constexpr (!K_ADDED) {
+      tmp0 += K[t];
+    }
+    sycl::ulong tmp1 = Σ_0(a) + maj(a, b, c);
 
-    *(out + i) = tmp0 + tmp1;
+    h = g;
+    g = f;
+    f = e;
+    e = d + tmp0;
+    d = c;
+    c = b;
+    b = a;
+    a = tmp0 + tmp1;
   }
+
+  const sycl::ulong tmp[8] = { a, b, c, d, e, f, g, h };
+
+#pragma unroll
+  for (size_t i = 0; i < OUT_WORDS; i++) {
+    state[i] += tmp[i];
+  }
+}
+
+// Message schedule of second message block, when hashing `MSG_WORDS` -many
+// message words ( two concatenated digests ), where round constants are
+// already added to each message schedule word; as second block only carries
+// padding, it's same for all inputs, so it's computed at compile-time
+template<size_t MSG_WORDS>
+constexpr std::array<sycl::ulong, 80>
+padding_block_schedule()
+{
+  std::array<sycl::ulong, 80> w{};
+
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = node_padding_word<sycl::ulong>(MSG_WORDS, 16 + i);
+  }
+
+  expand_message_schedule(w.data());
+
+  for (size_t i = 0; i < 80; i++) {
+    w[i] += K[i];
+  }
+
+  return w;
+}
+
+template<size_t MSG_WORDS>
+constexpr std::array<sycl::ulong, 80> PADDING_BLOCK_WK =
+  padding_block_schedule<MSG_WORDS>();
+
+// SHA2-{384,512,512/224,512/256} 2-to-1 hash function, computing digest of
+// `MSG_WORDS` -many message words ( two concatenated digests ), which are read
+// straight from `in`, without padding them into separate buffer first,
+// starting from initial hash state `iv`
+//
+// Padding words are compile-time constants, while message schedule of second
+// message block ( if any ), which only carries padding, is taken from
+// `PADDING_BLOCK_WK`; only first `OUT_WORDS` -many words of final hash state
+// are computed & written to `digest`
+//
+// See section 5.1.2 & 6.4.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t MSG_WORDS, size_t OUT_WORDS>
+inline void
+hash_node(const sycl::ulong* __restrict iv,
+          const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  sycl::ulong msg_schld[80];
+  sycl::ulong state[8];
+
+#pragma unroll 16
+  for (size_t i = 0; i < 16; i++) {
+    msg_schld[i] =
+      i < MSG_WORDS ? in[i] : node_padding_word<sycl::ulong>(MSG_WORDS, i);
+  }
+
+  expand_message_schedule(msg_schld);
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = iv[i];
+  }
+
+  if constexpr (node_block_cnt(MSG_WORDS) == 1) {
+    compress_schedule<OUT_WORDS, false>(msg_schld, state);
+  } else {
+    compress_schedule<8, false>(msg_schld, state);
+    compress_schedule<OUT_WORDS, true>(PADDING_BLOCK_WK<MSG_WORDS>.data(),
+                                       state);
+  }
+
+#pragma unroll
+  for (size_t i = 0; i < OUT_WORDS; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// One round of SHA2-{384,512,512/224,512/256} compression, at compile-time
+// known round index `t`, consuming `wk` ( message schedule word, added with
+// round constant ) into hash state `s`
+//
+// Working variables are not shifted after each round, rather each round finds
+// them at rotated indices of `s`, where new `a` & `e` overwrite old `h` & `d`;
+// as `t` is known at compile-time, so are all indices, letting whole hash state
+// live in registers
+//
+// See step 3 of algorithm defined in section 6.4.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t t>
+static inline void
+rnd_step(sycl::ulong* const s, const sycl::ulong wk)
+{
+  constexpr size_t a = (8 - (t & 7)) & 7;
+  constexpr size_t b = (a + 1) & 7;
+  constexpr size_t c = (a + 2) & 7;
+  constexpr size_t d = (a + 3) & 7;
+  constexpr size_t e = (a + 4) & 7;
+  constexpr size_t f = (a + 5) & 7;
+  constexpr size_t g = (a + 6) & 7;
+  constexpr size_t h = (a + 7) & 7;
+
+  const sycl::ulong tmp0 = s[h] + Σ_1(s[e]) + ch(s[e], s[f], s[g]) + wk;
+  const sycl::ulong tmp1 = Σ_0(s[a]) + maj(s[a], s[b], s[c]);
+
+  s[d] += tmp0;
+  s[h] = tmp0 + tmp1;
+}
+
+// Round `t` of SHA2-{384,512,512/224,512/256} compression, where message
+// schedule word is computed in-place, in 16 -word circular window `w`, right
+// before it's consumed, while round constant `K[t]` is an immediate; so that
+// all 80 message schedule words are never materialized at once
+//
+// See step 1 & 3 of algorithm defined in section 6.4.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<size_t t>
+static inline void
+rolling_rnd(sycl::ulong* const s, sycl::ulong* const w)
+{
+  if constexpr (t >= 16) {
+    w[t & 15] += σ_1(w[(t - 2) & 15]) + w[(t - 7) & 15] + σ_0(w[(t - 15) & 15]);
+  }
+
+  constexpr sycl::ulong k = K[t];
+  rnd_step<t>(s, k + w[t & 15]);
+}
+
+template<size_t... t>
+static inline void
+rolling_rnds(sycl::ulong* const s,
+             sycl::ulong* const w,
+             std::index_sequence<t...>)
+{
+  (rolling_rnd<t>(s, w), ...);
+}
+
+template<size_t MSG_WORDS, size_t... t>
+static inline void
+padding_rnds(sycl::ulong* const s, std::index_sequence<t...>)
+{
+  (rnd_step<t>(s, PADDING_BLOCK_WK<MSG_WORDS>[t]), ...);
+}
+
+// Register-lean alternative to `hash_node`, computing same digest, where rounds
+// are fully unrolled at compile-time, while message schedule is computed in a
+// 16 -word circular window, interleaved with rounds ( see `rolling_rnd` ),
+// instead of being materialized as 80 -word array, which otherwise inflates
+// private memory usage of each work-item
+//
+// Second message block ( if any ), which only carries padding, consumes
+// `PADDING_BLOCK_WK`, whose words are immediates too
+template<size_t MSG_WORDS, size_t OUT_WORDS>
+inline void
+hash_node_rolling(const sycl::ulong* __restrict iv,
+                  const sycl::ulong* __restrict in,
+                  sycl::ulong* const __restrict digest)
+{
+  sycl::ulong w[16];
+  sycl::ulong s[8];
+
+#pragma unroll 16
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = i < MSG_WORDS ? in[i] : node_padding_word<sycl::ulong>(MSG_WORDS, i);
+  }
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    s[i] = iv[i];
+  }
+
+  rolling_rnds(s, w, std::make_index_sequence<80>{});
+
+  if constexpr (node_block_cnt(MSG_WORDS) == 2) {
+    sycl::ulong mid[8];
+
+#pragma unroll 8
+    for (size_t i = 0; i < 8; i++) {
+      mid[i] = s[i] + iv[i];
+      s[i] = mid[i];
+    }
+
+    padding_rnds<MSG_WORDS>(s, std::make_index_sequence<80>{});
+
+#pragma unroll
+    for (size_t i = 0; i < OUT_WORDS; i++) {
+      digest[i] = s[i] + mid[i];
+    }
+  } else {
+#pragma unroll
+    for (size_t i = 0; i < OUT_WORDS; i++) {
+      digest[i] = s[i] + iv[i];
+    }
+  }
+}
+
+// Computes SHA2-{384,512,512/224,512/256} hash state after consuming `len`
+// -bytes message, which can be of arbitrary length, starting from initial hash
+// state `iv`; message is padded as specified in section 5.1.2 of Secure Hash
+// Standard, while all eight words of final hash state are written to `state`,
+// which is to be truncated by caller
+//
+// See section 6.4.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::ulong* __restrict iv,
+             const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::ulong* const __restrict state)
+{
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = iv[i];
+  }
+
+  for_each_padded_block<sycl::ulong, 128, 16>(
+    msg, len, [&](const sycl::ulong* blk) { compress(blk, state); });
 }
 
 }
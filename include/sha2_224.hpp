@@ -175,4 +175,48 @@ hash(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
   }
 }
 
+// 2-to-1 hash function, which reads two concatenated SHA2-224 digests ( = 14
+// words, each 32 -bit wide ) straight from `in`, without padding them into
+// separate buffer first, producing 224 -bit digest, as seven 32 -bit words;
+// schedule of second message block, which only carries padding, is computed at
+// compile-time, while remaining words of final hash state are never computed
+//
+// See section 5.1.1 & 6.3 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_node(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
+{
+  sha2::word_32::hash_node<14, 7>(IV_0, in, digest);
+}
+
+// Same as above, but computed using register-lean compression core, which
+// keeps message schedule in 16 -word circular window, while all rounds are
+// unrolled at compile-time ( see `sha2::word_32::hash_node_rolling` )
+void
+hash_node_rolling(const sycl::uint* __restrict in,
+                  sycl::uint* const __restrict digest)
+{
+  sha2::word_32::hash_node_rolling<14, 7>(IV_0, in, digest);
+}
+
+// Computes 224 -bit SHA2-224 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, writing it as seven 32
+// -bit words
+//
+// See section 5.1 & 6 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uint* const __restrict digest)
+{
+  sycl::uint state[8];
+  sha2::word_32::hash_message(IV_0, msg, len, state);
+
+#pragma unroll 7
+  for (size_t i = 0; i < 7; i++) {
+    digest[i] = state[i];
+  }
+}
+
 }
@@ -195,4 +195,42 @@ hash(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
   }
 }
 
+// 2-to-1 hash function, which reads two concatenated SHA2-256 digests ( = 16
+// words, each 32 -bit wide ) straight from `in`, without padding them into
+// separate buffer first, producing 256 -bit digest, as eight 32 -bit words;
+// schedule of second message block, which only carries padding, is computed at
+// compile-time
+//
+// See section 5.1.1 & 6.2 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_node(const sycl::uint* __restrict in, sycl::uint* const __restrict digest)
+{
+  sha2::word_32::hash_node<16, 8>(IV_0, in, digest);
+}
+
+// Same as above, but computed using register-lean compression core, which
+// keeps message schedule in 16 -word circular window, while all rounds are
+// unrolled at compile-time ( see `sha2::word_32::hash_node_rolling` )
+void
+hash_node_rolling(const sycl::uint* __restrict in,
+                  sycl::uint* const __restrict digest)
+{
+  sha2::word_32::hash_node_rolling<16, 8>(IV_0, in, digest);
+}
+
+// Computes 256 -bit SHA2-256 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, writing it as eight 32
+// -bit words
+//
+// See section 5.1 & 6 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uint* const __restrict digest)
+{
+  sha2::word_32::hash_message(IV_0, msg, len, digest);
+}
+
 }
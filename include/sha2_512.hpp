@@ -161,4 +161,43 @@ hash(const sycl::ulong* __restrict in, sycl::ulong* const __restrict digest)
   }
 }
 
+// 2-to-1 hash function, which reads two concatenated SHA2-512 digests ( = 16
+// words, each 64 -bit wide ) straight from `in`, without padding them into
+// separate buffer first, producing 512 -bit digest, as eight 64 -bit words;
+// schedule of second message block, which only carries padding, is computed at
+// compile-time
+//
+// See section 5.1.2 & 6.4 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_node(const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  sha2::word_64::hash_node<16, 8>(IV_0, in, digest);
+}
+
+// Same as above, but computed using register-lean compression core, which
+// keeps message schedule in 16 -word circular window, while all rounds are
+// unrolled at compile-time ( see `sha2::word_64::hash_node_rolling` )
+void
+hash_node_rolling(const sycl::ulong* __restrict in,
+                  sycl::ulong* const __restrict digest)
+{
+  sha2::word_64::hash_node_rolling<16, 8>(IV_0, in, digest);
+}
+
+// Computes 512 -bit SHA2-512 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, writing it as eight 64
+// -bit words
+//
+// See section 5.1 & 6 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::ulong* const __restrict digest)
+{
+  sha2::word_64::hash_message(IV_0, msg, len, digest);
+}
+
 }
@@ -140,4 +140,48 @@ hash(const sycl::ulong* __restrict in, sycl::ulong* const __restrict digest)
   *(digest + 3) = IV_0[3] + d;
 }
 
+// 2-to-1 hash function, which reads two concatenated SHA2-512/256 digests ( = 8
+// words, each 64 -bit wide ) straight from `in`, without padding them into
+// separate buffer first, producing 256 -bit digest, as four 64 -bit words,
+// while remaining words of final hash state are never computed
+//
+// See section 5.1.2 & 6.7 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_node(const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  sha2::word_64::hash_node<8, 4>(IV_0, in, digest);
+}
+
+// Same as above, but computed using register-lean compression core, which
+// keeps message schedule in 16 -word circular window, while all rounds are
+// unrolled at compile-time ( see `sha2::word_64::hash_node_rolling` )
+void
+hash_node_rolling(const sycl::ulong* __restrict in,
+                  sycl::ulong* const __restrict digest)
+{
+  sha2::word_64::hash_node_rolling<8, 4>(IV_0, in, digest);
+}
+
+// Computes 256 -bit SHA2-512/256 digest of `len` -bytes message, which can be
+// of arbitrary length, unlike above 2-to-1 hash function, writing it as four 64
+// -bit words
+//
+// See section 5.1 & 6 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::ulong* const __restrict digest)
+{
+  sycl::ulong state[8];
+  sha2::word_64::hash_message(IV_0, msg, len, state);
+
+#pragma unroll 4
+  for (size_t i = 0; i < 4; i++) {
+    digest[i] = state[i];
+  }
+}
+
 }
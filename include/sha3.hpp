@@ -1,6 +1,7 @@
 #pragma once
 #include "utils.hpp"
 #include <CL/sycl.hpp>
+#include <utility>
 
 // Leftwards circular rotation offset of 24 lanes of state array ( except
 // lane(0, 0), which is not touched ), as provided in table 2 below algorithm 2
@@ -425,3 +426,326 @@ keccak_p(uint32_t* const state)
   rnd<1u, 32768u>(state);
   rnd<0u, 2147516546u>(state);
 }
+
+// Round constants of keccak-p[1600, 24], one for each round, as used by
+// `keccak_p_tree`; see section 3.2.5 of http://dx.doi.org/10.6028/NIST.FIPS.202
+constexpr sycl::ulong RC[24] = { 1ull,
+                                 32898ull,
+                                 9223372036854808714ull,
+                                 9223372039002292224ull,
+                                 32907ull,
+                                 2147483649ull,
+                                 9223372039002292353ull,
+                                 9223372036854808585ull,
+                                 138ull,
+                                 136ull,
+                                 2147516425ull,
+                                 2147483658ull,
+                                 2147516555ull,
+                                 9223372036854775947ull,
+                                 9223372036854808713ull,
+                                 9223372036854808579ull,
+                                 9223372036854808578ull,
+                                 9223372036854775936ull,
+                                 32778ull,
+                                 9223372039002259466ull,
+                                 9223372039002292353ull,
+                                 9223372036854808704ull,
+                                 2147483649ull,
+                                 9223372039002292232ull };
+
+// Lanes of state array, which are kept complemented by `keccak_p_tree`, so that
+// `χ` needs only one NOT per plane, instead of five; these are lanes (1, 0),
+// (2, 0), (3, 1), (2, 2), (2, 3) & (0, 4), with lane (x, y) at index 5y + x
+//
+// See lane complementing transform in section 2.2 of
+// https://keccak.team/files/Keccak-implementation-3.2.pdf
+constexpr uint32_t COMPLEMENTED_LANES =
+  1u << 1 | 1u << 2 | 1u << 8 | 1u << 12 | 1u << 17 | 1u << 20;
+
+// All 25 lanes of state array
+constexpr uint32_t ALL_LANES = (1u << 25) - 1u;
+
+// `χ` of lane (x, y), in terms of a = lane (x, y), b = lane (x + 1, y) & c =
+// lane (x + 2, y) of plane y, after lane complementing transform, such that
+// complemented lanes ( see `COMPLEMENTED_LANES` ) stay complemented
+enum class χ_op : uint8_t
+{
+  a_xor_b_or_c,     // a ^ (b | c)
+  a_xor_b_and_c,    // a ^ (b & c)
+  a_xor_nb_or_c,    // a ^ (~b | c)
+  a_xor_nb_and_c,   // a ^ (~b & c)
+  a_xor_b_or_nc,    // a ^ (b | ~c)
+  na_xor_b_or_c,    // ~a ^ (b | c)
+  na_xor_b_and_c    // ~a ^ (b & c)
+};
+
+constexpr χ_op CHI_OPS[25] = {
+  χ_op::a_xor_b_or_c,   χ_op::a_xor_nb_or_c,  χ_op::a_xor_b_and_c,
+  χ_op::a_xor_b_or_c,   χ_op::a_xor_b_and_c,  χ_op::a_xor_b_or_c,
+  χ_op::a_xor_b_and_c,  χ_op::a_xor_b_or_nc,  χ_op::a_xor_b_or_c,
+  χ_op::a_xor_b_and_c,  χ_op::a_xor_b_or_c,   χ_op::a_xor_b_and_c,
+  χ_op::a_xor_nb_and_c, χ_op::na_xor_b_or_c,  χ_op::a_xor_b_and_c,
+  χ_op::a_xor_b_and_c,  χ_op::a_xor_b_or_c,   χ_op::a_xor_nb_or_c,
+  χ_op::na_xor_b_and_c, χ_op::a_xor_b_or_c,   χ_op::a_xor_nb_and_c,
+  χ_op::na_xor_b_or_c,  χ_op::a_xor_b_and_c,  χ_op::a_xor_b_or_c,
+  χ_op::a_xor_b_and_c
+};
+
+// Reads lane `i` of state array, entering a round of `keccak_p_tree`, where
+// lanes not set in `LIVE` are known to be zero ( or all ones, when they're
+// complemented ), so that they're constant folded, instead of being read
+template<size_t i, uint32_t LIVE>
+static inline sycl::ulong
+tree_lane(const sycl::ulong* const state)
+{
+  if constexpr (((LIVE >> i) & 1u) == 1u) {
+    return state[i];
+  } else if constexpr (((COMPLEMENTED_LANES >> i) & 1u) == 1u) {
+    return ~0ull;
+  } else {
+    return 0ull;
+  }
+}
+
+// Column parity of column x, see step 1 of algorithm 1 in section 3.2.1 of
+// http://dx.doi.org/10.6028/NIST.FIPS.202
+template<size_t x, uint32_t LIVE>
+static inline sycl::ulong
+tree_column(const sycl::ulong* const state)
+{
+  return tree_lane<x, LIVE>(state) ^ tree_lane<x + 5, LIVE>(state) ^
+         tree_lane<x + 10, LIVE>(state) ^ tree_lane<x + 15, LIVE>(state) ^
+         tree_lane<x + 20, LIVE>(state);
+}
+
+// Applies `θ`, `ρ` & `π` for lane `i` = 5y + x of next state array, which is
+// why it reads lane (x + 3y, x) of current state array, as `π` moves it to
+// (x, y); so `π` only renames lanes, while nothing is copied
+template<size_t i, uint32_t LIVE>
+static inline sycl::ulong
+tree_θρπ(const sycl::ulong* const state, const sycl::ulong* const d)
+{
+  constexpr size_t x = i % 5;
+  constexpr size_t y = i / 5;
+  constexpr size_t col = (x + 3 * y) % 5;
+  constexpr size_t src = 5 * x + col;
+
+  const sycl::ulong lane = tree_lane<src, LIVE>(state) ^ d[col];
+
+  if constexpr (src == 0) {
+    return lane;
+  } else {
+    return rotl(lane, ROT[src - 1]);
+  }
+}
+
+// Applies `χ` for lane `i` = 5y + x of plane y, whose lanes ( after `θ`, `ρ`
+// & `π` ) are `b`, writing it to next state array, only when it's one of first
+// `OUT_LANES` -many lanes
+template<size_t i, size_t OUT_LANES>
+static inline void
+tree_χ(const sycl::ulong* const b, sycl::ulong* const state)
+{
+  if constexpr (i < OUT_LANES) {
+    constexpr size_t x = i % 5;
+    constexpr χ_op op = CHI_OPS[i];
+
+    const sycl::ulong a0 = b[x];
+    const sycl::ulong a1 = b[(x + 1) % 5];
+    const sycl::ulong a2 = b[(x + 2) % 5];
+
+    if constexpr (op == χ_op::a_xor_b_or_c) {
+      state[i] = a0 ^ (a1 | a2);
+    } else if constexpr (op == χ_op::a_xor_b_and_c) {
+      state[i] = a0 ^ (a1 & a2);
+    } else if constexpr (op == χ_op::a_xor_nb_or_c) {
+      state[i] = a0 ^ (~a1 | a2);
+    } else if constexpr (op == χ_op::a_xor_nb_and_c) {
+      state[i] = a0 ^ (~a1 & a2);
+    } else if constexpr (op == χ_op::a_xor_b_or_nc) {
+      state[i] = a0 ^ (a1 | ~a2);
+    } else if constexpr (op == χ_op::na_xor_b_or_c) {
+      state[i] = ~a0 ^ (a1 | a2);
+    } else {
+      state[i] = ~a0 ^ (a1 & a2);
+    }
+  }
+}
+
+// Computes plane y of next state array, skipping it when none of its lanes are
+// among first `OUT_LANES` -many lanes
+template<size_t y, uint32_t LIVE, size_t OUT_LANES, size_t... x>
+static inline void
+tree_plane(const sycl::ulong* __restrict in,
+           const sycl::ulong* __restrict d,
+           sycl::ulong* const __restrict out,
+           std::index_sequence<x...>)
+{
+  if constexpr (y * 5 < OUT_LANES) {
+    const sycl::ulong b[5] = { tree_θρπ<y * 5 + x, LIVE>(in, d)... };
+
+    (tree_χ<y * 5 + x, OUT_LANES>(b, out), ...);
+  }
+}
+
+// keccak-p[b, n_r] round `r`, consuming state array `in` ( where only lanes
+// set in `LIVE` may be non-zero ) & producing first `OUT_LANES` -many lanes of
+// next state array in `out`, with lane complementing transform applied on both
+template<size_t r, uint32_t LIVE, size_t OUT_LANES, size_t... y>
+static inline void
+tree_rnd(const sycl::ulong* __restrict in,
+         sycl::ulong* const __restrict out,
+         std::index_sequence<y...>)
+{
+  const sycl::ulong c[5] = { tree_column<y, LIVE>(in)... };
+  sycl::ulong d[5];
+
+#pragma unroll 5
+  for (size_t x = 0; x < 5; x++) {
+    d[x] = c[(x + 4) % 5] ^ rotl(c[(x + 1) % 5], 1);
+  }
+
+  (tree_plane<y, LIVE, OUT_LANES>(in, d, out, std::make_index_sequence<5>{}),
+   ...);
+
+  out[0] ^= RC[r];
+}
+
+// Applies rounds 2k & 2k + 1, ping-ponging state array between `state` & `tmp`,
+// where only first round sees lanes not set in `LIVE` as zero, while only last
+// round computes just first `OUT_LANES` -many lanes
+template<uint32_t LIVE, size_t OUT_LANES, size_t... k>
+static inline void
+tree_rnds(sycl::ulong* const __restrict state,
+          sycl::ulong* const __restrict tmp,
+          std::index_sequence<k...>)
+{
+  constexpr size_t N = sizeof...(k);
+
+  ((tree_rnd<k << 1, k == 0 ? LIVE : ALL_LANES, 25>(
+      state, tmp, std::make_index_sequence<5>{}),
+    tree_rnd<(k << 1) + 1, ALL_LANES, k == N - 1 ? OUT_LANES : 25>(
+      tmp, state, std::make_index_sequence<5>{})),
+   ...);
+}
+
+// keccak-p[1600, 24] permutation, specialized for 2-to-1 hashing in binary
+// merklization, computing same first `OUT_LANES` -many lanes as `keccak_p`
+// does, while remaining lanes of state array are left unspecified
+//
+// - lanes not set in `LIVE` ( say ones above input message & padding ) are
+// never read, as they're known to be zero, so they're constant folded in first
+// round
+// - `π` renames lanes, by reading lanes from their permuted positions, while
+// rounds ping-pong between two state arrays, instead of copying state array
+// to temporary array, every round
+// - lane complementing transform cuts # -of NOT operations in `χ`, from 25 to 5
+// per round
+// - last round only computes first `OUT_LANES` -many lanes, which reach digest
+//
+// See sections 2.2 & 2.4 of
+// https://keccak.team/files/Keccak-implementation-3.2.pdf
+template<uint32_t LIVE, size_t OUT_LANES>
+static inline void
+keccak_p_tree(sycl::ulong* const state)
+{
+  static_assert(OUT_LANES > 0 && OUT_LANES <= 25);
+
+  sycl::ulong tmp[25];
+
+#pragma unroll 25
+  for (size_t i = 0; i < 25; i++) {
+    if (((LIVE & COMPLEMENTED_LANES) >> i) & 1u) {
+      state[i] = ~state[i];
+    }
+  }
+
+  tree_rnds<LIVE, OUT_LANES>(state, tmp, std::make_index_sequence<12>{});
+
+#pragma unroll 25
+  for (size_t i = 0; i < OUT_LANES; i++) {
+    if ((COMPLEMENTED_LANES >> i) & 1u) {
+      state[i] = ~state[i];
+    }
+  }
+}
+
+// Keccak sponge construction over keccak-p[1600, 24], which absorbs `len`
+// -bytes message ( of arbitrary length ) RATE bytes at a time, after padding it
+// using domain separation bits DSEP followed by pad10*1 rule, and then
+// squeezes OUT_LEN ( <= RATE ) -bytes digest out of state array
+//
+// DSEP is 0b110 ( read right to left ) for SHA3 variants, while it's 0b1 for
+// keccak-256; see sections 4, 5.1 & 6.1 of
+// http://dx.doi.org/10.6028/NIST.FIPS.202
+template<size_t RATE, sycl::uchar DSEP, size_t OUT_LEN>
+static inline void
+sponge(const sycl::uchar* __restrict msg,
+       size_t len,
+       sycl::uchar* const __restrict digest)
+{
+  static_assert(RATE % 8 == 0 && OUT_LEN <= RATE);
+
+  constexpr size_t LANE_CNT = RATE >> 3;
+
+  sycl::ulong state[25];
+
+#pragma unroll 25
+  for (size_t i = 0; i < 25; i++) {
+    state[i] = 0ull;
+  }
+
+  // absorb all complete message blocks, where each consecutive 8 bytes are
+  // interpreted as little endian 64 -bit lane
+  const size_t blk_cnt = len / RATE;
+  for (size_t b = 0; b < blk_cnt; b++) {
+    const sycl::uchar* blk = msg + b * RATE;
+
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      sycl::ulong lane = 0ull;
+
+#pragma unroll 8
+      for (size_t j = 0; j < 8; j++) {
+        lane |= static_cast<sycl::ulong>(blk[(i << 3) + j]) << (j << 3);
+      }
+
+      state[i] ^= lane;
+    }
+
+    keccak_p(state);
+  }
+
+  // absorb last ( padded ) message block
+  const size_t rem = len - blk_cnt * RATE;
+
+  sycl::uchar tail[RATE];
+
+  for (size_t i = 0; i < rem; i++) {
+    tail[i] = msg[blk_cnt * RATE + i];
+  }
+  for (size_t i = rem; i < RATE; i++) {
+    tail[i] = 0;
+  }
+  tail[rem] ^= DSEP;
+  tail[RATE - 1] ^= 0b10000000;
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    sycl::ulong lane = 0ull;
+
+#pragma unroll 8
+    for (size_t j = 0; j < 8; j++) {
+      lane |= static_cast<sycl::ulong>(tail[(i << 3) + j]) << (j << 3);
+    }
+
+    state[i] ^= lane;
+  }
+
+  keccak_p(state);
+
+  // squeeze digest out of first OUT_LEN -bytes of state array
+#pragma unroll 8
+  for (size_t i = 0; i < OUT_LEN; i++) {
+    digest[i] = static_cast<sycl::uchar>(state[i >> 3] >> ((i & 7) << 3));
+  }
+}
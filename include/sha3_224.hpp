@@ -116,4 +116,34 @@ hash(const sycl::uchar* __restrict in, sycl::uchar* const __restrict digest)
   to_digest_bytes(state, digest);
 }
 
+// Same as `hash`, but uses keccak-p[1600, 24] permutation specialized for
+// tree hashing ( see `keccak_p_tree` ), where only input & padding lanes ( =
+// lanes [0, 8) & 17 ) are read in first round, while only four lanes, carrying
+// 28 -bytes digest, are computed in last round
+void
+hash_tree(const sycl::uchar* __restrict in,
+          sycl::uchar* const __restrict digest)
+{
+  constexpr uint32_t LIVE = ((1u << 8) - 1u) | (1u << 17);
+
+  sycl::ulong state[25];
+
+  to_state_array(in, state);
+  keccak_p_tree<LIVE, 4>(state);
+  to_digest_bytes(state, digest);
+}
+
+// Computes 224 -bit SHA3-224 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, using sponge
+// construction with rate of 144 -bytes
+//
+// See section 6.1 of http://dx.doi.org/10.6028/NIST.FIPS.202
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uchar* const __restrict digest)
+{
+  sponge<144, 0b110, 28>(msg, len, digest);
+}
+
 }
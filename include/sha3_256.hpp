@@ -103,4 +103,95 @@ hash(const sycl::uchar* __restrict in, sycl::uchar* const __restrict digest)
   to_digest_bytes(state, digest);
 }
 
+// Prepares 5 x 5 x 64 keccak state array from input, given as eight 64 -bit
+// lanes, which are placed in state array as they are, instead of being
+// assembled byte-by-byte, as above; see `hash_lanes`
+void
+to_state_array(const sycl::ulong* __restrict in,
+               sycl::ulong* const __restrict state)
+{
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = in[i];
+  }
+
+  // same padding bits as above
+  state[8] = 0b110ull;
+
+#pragma unroll 7
+  for (size_t i = 9; i < 16; i++) {
+    state[i] = 0ull;
+  }
+
+  state[16] = 9223372036854775808ull;
+
+#pragma unroll 8
+  for (size_t i = 17; i < 25; i++) {
+    state[i] = 0ull;
+  }
+}
+
+// SHA3-256 2-to-1 hasher, where input is eight 64 -bit lanes ( = 64 bytes ),
+// which is hashed to produce four 64 -bit lanes ( = 32 -bytes digest )
+//
+// Each lane holds 8 consecutive bytes in little-endian order, which is how
+// keccak-p[1600, 24] state array lanes are defined, so in memory of a little
+// endian device, lanes are byte-for-byte same as standard digest, while no
+// byte is assembled/ scattered when hashing
+void
+hash_lanes(const sycl::ulong* __restrict in,
+           sycl::ulong* const __restrict digest)
+{
+  sycl::ulong state[25];
+
+  to_state_array(in, state);
+  keccak_p(state);
+
+#pragma unroll 4
+  for (size_t i = 0; i < 4; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Same as `hash_lanes`, but uses keccak-p[1600, 24] permutation specialized
+// for tree hashing ( see `keccak_p_tree` ), where only input & padding lanes (
+// = lanes [0, 9) & 16 ) are set, while only four lanes of digest are computed
+// in last round
+void
+hash_tree(const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  constexpr uint32_t LIVE = ((1u << 9) - 1u) | (1u << 16);
+
+  sycl::ulong state[25];
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    state[i] = in[i];
+  }
+
+  state[8] = 0b110ull;
+  state[16] = 9223372036854775808ull;
+
+  keccak_p_tree<LIVE, 4>(state);
+
+#pragma unroll 4
+  for (size_t i = 0; i < 4; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Computes 256 -bit SHA3-256 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, using sponge
+// construction with rate of 136 -bytes
+//
+// See section 6.1 of http://dx.doi.org/10.6028/NIST.FIPS.202
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uchar* const __restrict digest)
+{
+  sponge<136, 0b110, 32>(msg, len, digest);
+}
+
 }
@@ -93,4 +93,86 @@ hash(const sycl::uchar* __restrict in, sycl::uchar* const __restrict digest)
   to_digest_bytes(state, digest);
 }
 
+// Prepares 5 x 5 x 64 keccak state array from input, given as twelve 64 -bit
+// lanes, which are placed in state array as they are, instead of being
+// assembled byte-by-byte, as above; see `hash_lanes`
+void
+to_state_array(const sycl::ulong* __restrict in,
+               sycl::ulong* const __restrict state)
+{
+#pragma unroll 6
+  for (size_t i = 0; i < (IN_LEN_BYTES >> 3); i++) {
+    state[i] = in[i];
+  }
+
+  // same padding bits as above
+  state[12] = 9223372036854775814ull;
+
+#pragma unroll 6
+  for (size_t i = 13; i < 25; i++) {
+    state[i] = 0ull;
+  }
+}
+
+// SHA3-384 2-to-1 hasher, where input is twelve 64 -bit lanes ( = 96 bytes ),
+// which is hashed to produce six 64 -bit lanes ( = 48 -bytes digest )
+//
+// Each lane holds 8 consecutive bytes in little-endian order, which is how
+// keccak-p[1600, 24] state array lanes are defined, so no byte is assembled/
+// scattered when hashing
+void
+hash_lanes(const sycl::ulong* __restrict in,
+           sycl::ulong* const __restrict digest)
+{
+  sycl::ulong state[25];
+
+  to_state_array(in, state);
+  keccak_p(state);
+
+#pragma unroll 6
+  for (size_t i = 0; i < 6; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Same as `hash_lanes`, but uses keccak-p[1600, 24] permutation specialized
+// for tree hashing ( see `keccak_p_tree` ), where only input & padding lanes (
+// = lanes [0, 13) ) are set, while only six lanes of digest are computed in
+// last round
+void
+hash_tree(const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  constexpr uint32_t LIVE = (1u << 13) - 1u;
+
+  sycl::ulong state[25];
+
+#pragma unroll 6
+  for (size_t i = 0; i < 12; i++) {
+    state[i] = in[i];
+  }
+
+  state[12] = 9223372036854775814ull;
+
+  keccak_p_tree<LIVE, 6>(state);
+
+#pragma unroll 6
+  for (size_t i = 0; i < 6; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Computes 384 -bit SHA3-384 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, using sponge
+// construction with rate of 104 -bytes
+//
+// See section 6.1 of http://dx.doi.org/10.6028/NIST.FIPS.202
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uchar* const __restrict digest)
+{
+  sponge<104, 0b110, 48>(msg, len, digest);
+}
+
 }
@@ -89,6 +89,43 @@ process_remaining_448_bits(const sycl::uchar* __restrict in,
   }
 }
 
+// Lane counterparts of above two functions, where input is given as sixteen
+// 64 -bit lanes, which are placed in state array as they are, instead of being
+// assembled byte-by-byte; see `hash_lanes`
+void
+process_first_576_bits(const sycl::ulong* __restrict in,
+                       sycl::ulong* const __restrict state)
+{
+#pragma unroll 3
+  for (size_t i = 0; i < (RATE_LEN_BYTES >> 3); i++) {
+    state[i] = in[i];
+  }
+
+#pragma unroll 8
+  for (size_t i = 9; i < 25; i++) {
+    state[i] = 0ull;
+  }
+}
+
+void
+process_remaining_448_bits(const sycl::ulong* __restrict in,
+                           sycl::ulong* const __restrict state)
+{
+#pragma unroll 7
+  for (size_t i = 0; i < ((IN_LEN_BITS - RATE_LEN_BITS) >> 6); i++) {
+    state[i] = in[i];
+  }
+
+  // same padding bits as above
+  state[7] = 0b110ull;
+  state[8] = 9223372036854775808ull;
+
+#pragma unroll 8
+  for (size_t i = 9; i < 25; i++) {
+    state[i] = 0ull;
+  }
+}
+
 // Because RATE is small enough ( = 576 -bits ) that I'm required to absorb
 // whole padded input bits in two phases, after performing keccak-p[b, n_r]
 // permutation on first 576 input -bits, before second permutation can be
@@ -160,4 +197,79 @@ hash(const sycl::uchar* __restrict in, sycl::uchar* const __restrict digest)
   to_digest_bytes(state_1, digest);
 }
 
+// SHA3-512 2-to-1 hasher, where input is sixteen 64 -bit lanes ( = 128 bytes
+// ), which is hashed to produce eight 64 -bit lanes ( = 64 -bytes digest )
+//
+// Each lane holds 8 consecutive bytes in little-endian order, which is how
+// keccak-p[1600, 24] state array lanes are defined, so no byte is assembled/
+// scattered when hashing
+void
+hash_lanes(const sycl::ulong* __restrict in,
+           sycl::ulong* const __restrict digest)
+{
+  sycl::ulong state_0[25];
+  sycl::ulong state_1[25];
+
+  process_first_576_bits(in, state_0);
+  keccak_p(state_0);
+
+  process_remaining_448_bits(in + 9, state_1);
+  mix_prev_into_cur_state(state_0, state_1);
+  keccak_p(state_1);
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    digest[i] = state_1[i];
+  }
+}
+
+// Same as `hash_lanes`, but uses keccak-p[1600, 24] permutation specialized
+// for tree hashing ( see `keccak_p_tree` ), where first permutation only reads
+// first 9 input lanes ( = RATE ), while remaining 7 input lanes & padding are
+// mixed into same state array, before second permutation, which only computes
+// eight lanes of digest in last round
+void
+hash_tree(const sycl::ulong* __restrict in,
+          sycl::ulong* const __restrict digest)
+{
+  constexpr uint32_t LIVE = (1u << 9) - 1u;
+
+  sycl::ulong state[25];
+
+#pragma unroll 3
+  for (size_t i = 0; i < 9; i++) {
+    state[i] = in[i];
+  }
+
+  keccak_p_tree<LIVE, 25>(state);
+
+#pragma unroll 7
+  for (size_t i = 0; i < 7; i++) {
+    state[i] ^= in[9 + i];
+  }
+
+  state[7] ^= 0b110ull;
+  state[8] ^= 9223372036854775808ull;
+
+  keccak_p_tree<ALL_LANES, 8>(state);
+
+#pragma unroll 8
+  for (size_t i = 0; i < 8; i++) {
+    digest[i] = state[i];
+  }
+}
+
+// Computes 512 -bit SHA3-512 digest of `len` -bytes message, which can be of
+// arbitrary length, unlike above 2-to-1 hash function, using sponge
+// construction with rate of 72 -bytes
+//
+// See section 6.1 of http://dx.doi.org/10.6028/NIST.FIPS.202
+void
+hash_message(const sycl::uchar* __restrict msg,
+             size_t len,
+             sycl::uchar* const __restrict digest)
+{
+  sponge<72, 0b110, 64>(msg, len, digest);
+}
+
 }
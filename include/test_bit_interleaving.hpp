@@ -12,7 +12,8 @@ gt_n(const size_t rounds, const size_t n)
 // Generate random 64 -bit unsigned integer, which is transformed to bit
 // interleaved form ( even & odd parts ) & again converted back to standard
 // representation by merging bit interleaved even, odd parts --- assert equality
-// of final standard representation and original u64 random number generated
+// of final standard representation and original u64 random number generated;
+// also asserts that constant-time conversions produce same result
 template<const size_t rounds>
 void
 test_bit_interleaving() requires(gt_n(rounds, 0))
@@ -31,5 +32,12 @@ test_bit_interleaving() requires(gt_n(rounds, 0))
     const uint64_t word_ = from_bit_interleaved(even, odd);
 
     assert(word == word_);
+
+    // constant-time conversions must agree with bit-by-bit ones
+    uint32_t even_, odd_;
+
+    to_bit_interleaved_fast(word, &even_, &odd_);
+    assert(even == even_ && odd == odd_);
+    assert(from_bit_interleaved_fast(even, odd) == word);
   }
 }
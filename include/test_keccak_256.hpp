@@ -23,6 +23,12 @@ test_keccak_256(sycl::queue& q)
   sycl::uchar* in = static_cast<sycl::uchar*>(sycl::malloc_shared(64, q));
   sycl::uchar* out_0 = static_cast<sycl::uchar*>(sycl::malloc_shared(32, q));
   sycl::uchar* out_1 = static_cast<sycl::uchar*>(sycl::malloc_shared(32, q));
+  sycl::ulong* in_lanes =
+    static_cast<sycl::ulong*>(sycl::malloc_shared(64, q));
+  sycl::ulong* out_lanes =
+    static_cast<sycl::ulong*>(sycl::malloc_shared(32, q));
+  sycl::ulong* out_tree =
+    static_cast<sycl::ulong*>(sycl::malloc_shared(32, q));
 
 #pragma unroll 16
   for (size_t i = 0; i < 64; i++) {
@@ -30,10 +36,23 @@ test_keccak_256(sycl::queue& q)
     in[i] = i;
   }
 
+#pragma unroll 4
+  for (size_t i = 0; i < (64 >> 3); i++) {
+    sycl::ulong lane = 0ul;
+
+    // same input, as little-endian 64 -bit lanes
+    for (size_t j = 0; j < 8; j++) {
+      lane |= static_cast<sycl::ulong>((i << 3) + j) << (j << 3);
+    }
+    in_lanes[i] = lane;
+  }
+
   // enqueue kernel execution in single work-item model
   q.single_task<class kernelTestKeccak_256>([=]() {
     keccak_256::hash(in, out_0);
     keccak_256::hash_u32(in, out_1);
+    keccak_256::hash_lanes(in_lanes, out_lanes);
+    keccak_256::hash_tree(in_lanes, out_tree);
   });
   q.wait();
 
@@ -41,10 +60,15 @@ test_keccak_256(sycl::queue& q)
   for (size_t i = 0; i < 32; i++) {
     assert(out_0[i] == expected[i]);
     assert(out_1[i] == expected[i]);
+    assert(((out_lanes[i >> 3] >> ((i & 7) << 3)) & 0xff) == expected[i]);
+    assert(((out_tree[i >> 3] >> ((i & 7) << 3)) & 0xff) == expected[i]);
   }
 
   // ensure resources are deallocated
   sycl::free(in, q);
   sycl::free(out_0, q);
   sycl::free(out_1, q);
+  sycl::free(in_lanes, q);
+  sycl::free(out_lanes, q);
+  sycl::free(out_tree, q);
 }
@@ -0,0 +1,149 @@
+#pragma once
+#include "merklize_arbitrary.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <cstring>
+
+// 2-to-1 hashes two intermediate nodes `a` & `b`, writing digest to `out`
+template<typename H>
+void
+hash_node_pair(const typename H::word_t* const a,
+               const typename H::word_t* const b,
+               typename H::word_t* const out)
+{
+  typename H::word_t in_words[H::NODE_WORDS << 1];
+
+  for (size_t i = 0; i < H::NODE_WORDS; i++) {
+    in_words[i] = a[i];
+    in_words[H::NODE_WORDS + i] = b[i];
+  }
+
+  node::hash_nodes<H>(in_words, out);
+}
+
+// Merkle tree hash of `n` -many consecutive leaf nodes ( each NODE_WORDS -many
+// words wide ), computed recursively, as defined in
+// https://www.rfc-editor.org/rfc/rfc6962#section-2.1
+template<typename H>
+void
+rfc6962_root(const typename H::word_t* const leaves,
+             size_t n,
+             typename H::word_t* const out)
+{
+  if (n == 1) {
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      out[i] = leaves[i];
+    }
+    return;
+  }
+
+  // largest power of 2 lesser than n
+  size_t k = 1;
+  while ((k << 1) < n) {
+    k <<= 1;
+  }
+
+  typename H::word_t l[H::NODE_WORDS];
+  typename H::word_t r[H::NODE_WORDS];
+
+  rfc6962_root<H>(leaves, k, l);
+  rfc6962_root<H>(leaves + k * H::NODE_WORDS, n - k, r);
+  hash_node_pair<H>(l, r, out);
+}
+
+// Merklizes random leaf nodes of arbitrary count, using `merklize_arbitrary`,
+// and asserts that all intermediate nodes are same as computed on host, level
+// by level, for each odd node policy; for power of 2 leaf counts output is also
+// compared against `merklize`, while for `rfc6962` policy root is also compared
+// against recursively computed merkle tree hash
+template<typename H>
+void
+test_merklize_arbitrary(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t wg_size = 1 << 5;
+  constexpr size_t leaf_cnts[] = { 2, 3, 5, 6, 7, 11, 100, 127, 128, 1000 };
+  constexpr odd_node_policy policies[] = { odd_node_policy::promote,
+                                           odd_node_policy::duplicate,
+                                           odd_node_policy::rfc6962 };
+
+  for (size_t leaf_cnt : leaf_cnts) {
+    const size_t itmd_cnt = intermediate_cnt(leaf_cnt);
+    const size_t i_size =
+      ((leaf_cnt + 1) >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+    const size_t o_size = (itmd_cnt + 1) * H::NODE_LEN_BYTES;
+
+    const size_t lvl_cnt = level_cnt(leaf_cnt);
+    const std::vector<size_t> offsets = level_offsets(leaf_cnt);
+
+    // acquire resources
+    word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+    word_t* out = (word_t*)sycl::malloc_shared(o_size, q);
+    word_t* leaves = (word_t*)std::malloc(leaf_cnt * H::NODE_LEN_BYTES);
+    word_t* expected = (word_t*)sycl::malloc_shared(o_size, q);
+
+    fill_random(in, i_size);
+
+    for (size_t i = 0; i < leaf_cnt; i++) {
+      node::leaf_at<H>(in, i, leaves + i * H::NODE_WORDS);
+    }
+
+    for (odd_node_policy policy : policies) {
+      const bool duplicate = policy == odd_node_policy::duplicate;
+
+      q.memset(out, 0, o_size).wait();
+      merklize_arbitrary<H>(
+        q, in, i_size, leaf_cnt, out, o_size, itmd_cnt, wg_size, policy);
+
+      // compute expected intermediate nodes on host, level by level
+      std::memset(expected, 0, o_size);
+      for (size_t lvl = 1; lvl <= lvl_cnt; lvl++) {
+        const size_t node_cnt = level_node_cnt(leaf_cnt, lvl);
+        const size_t child_cnt = level_node_cnt(leaf_cnt, lvl - 1);
+        const word_t* children =
+          lvl == 1 ? leaves : expected + offsets[lvl - 1] * H::NODE_WORDS;
+
+        for (size_t i = 0; i < node_cnt; i++) {
+          const word_t* a = children + (i << 1) * H::NODE_WORDS;
+          word_t* o = expected + (offsets[lvl] + i) * H::NODE_WORDS;
+
+          if ((i << 1) + 1 < child_cnt) {
+            hash_node_pair<H>(a, a + H::NODE_WORDS, o);
+          } else if (duplicate) {
+            hash_node_pair<H>(a, a, o);
+          } else {
+            std::memcpy(o, a, H::NODE_LEN_BYTES);
+          }
+        }
+      }
+
+      for (size_t i = 0; i < (itmd_cnt + 1) * H::NODE_WORDS; i++) {
+        assert(out[i] == expected[i]);
+      }
+
+      if (policy == odd_node_policy::rfc6962) {
+        word_t root[H::NODE_WORDS];
+        rfc6962_root<H>(leaves, leaf_cnt, root);
+
+        for (size_t i = 0; i < H::NODE_WORDS; i++) {
+          assert(out[H::NODE_WORDS + i] == root[i]);
+        }
+      }
+
+      if ((leaf_cnt & (leaf_cnt - 1)) == 0) {
+        reference_merklize<H>(q, in, leaf_cnt, expected);
+
+        for (size_t i = 0; i < (itmd_cnt + 1) * H::NODE_WORDS; i++) {
+          assert(out[i] == expected[i]);
+        }
+      }
+    }
+
+    // ensure resources are deallocated
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(expected, q);
+    std::free(leaves);
+  }
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include "merklize_autotune.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// Tunes work-group sizes of hasher policy on small tree, asserting that each
+// tuned work-group size is usable for its level, while merklization using
+// tuned settings ( both directly & through `autotuner` ) produces same
+// intermediate nodes as `merklize`; also asserts that tuned settings survive
+// round trip through cache file, which keeps lines of other devices intact
+template<typename H>
+void
+test_merklize_autotune(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 8;
+  constexpr size_t lvl = 7;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  hasher::variant v;
+  {
+    const bool found = hasher::from_id(H::ID, &v);
+    assert(found);
+  }
+
+  size_t wg_sizes[TUNED_LVL_CNT];
+  tune_wg_sizes<H>(q, leaf_cnt, 1, wg_sizes);
+
+  for (size_t k = 0; k < TUNED_LVL_CNT; k++) {
+    if (k <= lvl) {
+      assert(wg_sizes[k] >= 1 && wg_sizes[k] <= (1ul << k));
+      assert((wg_sizes[k] & (wg_sizes[k] - 1)) == 0);
+    } else {
+      assert(wg_sizes[k] == 0);
+    }
+  }
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  {
+    size_t lvl_wg_sizes[TUNED_LVL_CNT];
+    resolve_wg_sizes(wg_sizes, lvl_wg_sizes);
+
+    q.memset(out_1, 0, o_size).wait();
+    merklize_tuned<H>(
+      q, in, i_size, leaf_cnt, out_1, o_size, leaf_cnt - 1, lvl_wg_sizes);
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  char path[] = "/tmp/merklize_tuning_XXXXXX";
+  {
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    std::ofstream f(path);
+    f << "some other device\tsha1\tsha1\t1\n";
+  }
+
+  {
+    autotuner tuner{ q, path };
+    assert(!tuner.tuned(v));
+
+    const bool saved = tuner.tune(v, leaf_cnt, 1, false);
+    assert(saved);
+
+    for (hasher::variant v_ : alternatives(v)) {
+      assert(tuner.tuned(v_));
+      assert(tuner.config(v_).preferred == tuner.config(v).preferred);
+    }
+  }
+
+  {
+    // settings are picked up from cache file
+    autotuner tuner{ q, path };
+    assert(tuner.tuned(v));
+
+    const tuned_config cfg = tuner.config(v);
+    size_t k = 0;
+    for (; k <= lvl; k++) {
+      assert(cfg.wg_sizes[k] >= 1 && cfg.wg_sizes[k] <= (1ul << k));
+    }
+    for (; k < TUNED_LVL_CNT; k++) {
+      assert(cfg.wg_sizes[k] == 0);
+    }
+
+    q.memset(out_1, 0, o_size).wait();
+    tuner.merklize(v, in, i_size, leaf_cnt, out_1, o_size, leaf_cnt - 1);
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  {
+    std::ifstream f(path);
+    std::string line;
+    std::getline(f, line);
+    assert(line == "some other device\tsha1\tsha1\t1");
+  }
+
+  std::remove(path);
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
+
+// Tunes work-group sizes of SHA2-512 ( which compresses two message blocks per
+// 2-to-1 hash ), on tree wide enough that sweep would go past work-group size
+// limit of its kernels, if it were bounded only by device, asserting that no
+// tuned work-group size exceeds `max_merklize_wg_size`, while merklization
+// using tuned settings produces same intermediate nodes as `merklize`
+void
+test_merklize_autotune_wg_limit(sycl::queue& q)
+{
+  using H = hasher::sha2_512;
+  using word_t = typename H::word_t;
+
+  const size_t max_wg_size = max_merklize_wg_size<H>(q);
+  assert(max_wg_size >= 1);
+  assert(max_wg_size <=
+         q.get_device().get_info<sycl::info::device::max_work_group_size>());
+
+  // so that widest level has 2 * `max_wg_size` -many nodes
+  const size_t leaf_cnt = max_wg_size << 2;
+  const size_t lvl = static_cast<size_t>(
+    sycl::log2(static_cast<double>(leaf_cnt >> 1)));
+  const size_t wg_size = std::min(DEFAULT_WG_SIZE, max_wg_size);
+
+  const size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  const size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  size_t wg_sizes[TUNED_LVL_CNT];
+  tune_wg_sizes<H>(q, leaf_cnt, 1, wg_sizes);
+
+  for (size_t k = 0; k <= lvl; k++) {
+    assert(wg_sizes[k] >= 1 && wg_sizes[k] <= max_wg_size);
+    assert((wg_sizes[k] & (wg_sizes[k] - 1)) == 0);
+  }
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0, wg_size);
+
+  size_t lvl_wg_sizes[TUNED_LVL_CNT];
+  resolve_wg_sizes(wg_sizes, lvl_wg_sizes);
+
+  q.memset(out_1, 0, o_size).wait();
+  merklize_tuned<H>(
+    q, in, i_size, leaf_cnt, out_1, o_size, leaf_cnt - 1, lvl_wg_sizes);
+
+  for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+    assert(out_0[i] == out_1[i]);
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "merklize_batch.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes batch of differently sized binary merkle trees, using
+// `merklize_batch`, and asserts that intermediate nodes of each tree are same
+// as computed by `merklize`, when that tree is merklized alone; same is done
+// for batch of equal sized binary merkle trees
+template<typename H>
+void
+test_merklize_batch(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t wg_size = 1 << 5;
+
+  // leaf counts of trees in ragged batch
+  constexpr size_t leaf_cnts[] = { 2, 64, 4, 2, 256, 8, 16, 2, 1024, 32 };
+  constexpr size_t tree_cnt = sizeof(leaf_cnts) / sizeof(size_t);
+
+  // equal sized batch, with these many trees, each having 16 leaf nodes
+  constexpr size_t eq_tree_cnt = 1 << 7;
+  constexpr size_t eq_leaf_cnt = 1 << 4;
+
+  auto check = [&](const size_t* leaf_offs, size_t tree_cnt_, bool equal) {
+    const size_t total_leaf_cnt = leaf_offs[tree_cnt_];
+    const size_t i_size =
+      (total_leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+    const size_t o_size = total_leaf_cnt * H::NODE_LEN_BYTES;
+
+    // acquire resources
+    word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+    word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+    word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+    fill_random(in, i_size);
+
+    // each tree merklized alone, writing to its own region of output memory
+    for (size_t t = 0; t < tree_cnt_; t++) {
+      reference_merklize<H>(q,
+                            in + (leaf_offs[t] >> 1) * H::LEAF_PAIR_WORDS,
+                            leaf_offs[t + 1] - leaf_offs[t],
+                            out_0 + leaf_offs[t] * H::NODE_WORDS);
+    }
+
+    q.memset(out_1, 0, o_size).wait();
+    if (equal) {
+      merklize_batch<H>(
+        q, in, i_size, leaf_offs[1], tree_cnt_, out_1, o_size, wg_size);
+    } else {
+      merklize_batch<H>(
+        q, in, i_size, leaf_offs, tree_cnt_, out_1, o_size, wg_size);
+    }
+
+    for (size_t i = 0; i < total_leaf_cnt * H::NODE_WORDS; i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+
+    // ensure resources are deallocated
+    sycl::free(in, q);
+    sycl::free(out_0, q);
+    sycl::free(out_1, q);
+  };
+
+  {
+    size_t leaf_offs[tree_cnt + 1] = { 0 };
+    for (size_t t = 0; t < tree_cnt; t++) {
+      leaf_offs[t + 1] = leaf_offs[t] + leaf_cnts[t];
+    }
+
+    check(leaf_offs, tree_cnt, false);
+  }
+
+  {
+    size_t leaf_offs[eq_tree_cnt + 1] = { 0 };
+    for (size_t t = 0; t < eq_tree_cnt; t++) {
+      leaf_offs[t + 1] = leaf_offs[t] + eq_leaf_cnt;
+    }
+
+    check(leaf_offs, eq_tree_cnt, true);
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "merklize_file.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <cstdio>
+
+// Writes random leaf nodes to a temporary file, which is memory mapped and
+// merklized using `merklize_file`, `merklize_file_staged` ( with few chunks &
+// one chunk ) & `merklize_file_stream`, asserting that intermediate nodes &
+// root are same as `merklize` computes, on same leaf nodes living on
+// accelerator memory
+template<typename H>
+void
+test_merklize_file(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t chunk_leaf_cnt = 1 << 7;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // file which doesn't exist, can't be mapped
+  assert(!leaf_file("/nonexistent/leaf_nodes").valid());
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  char path[] = "/tmp/merklize_leaf_nodes_XXXXXX";
+  const int fd = mkstemp(path);
+  assert(fd >= 0);
+  const ssize_t n = write(fd, in, i_size);
+  assert(n == static_cast<ssize_t>(i_size));
+  close(fd);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  {
+    leaf_file f(path);
+    assert(f.valid());
+    assert(f.size() == i_size);
+
+    sycl::cl_ulong tx_ts[2];
+
+    q.memset(out_1, 0, o_size).wait();
+    merklize_file<H>(q, f, leaf_cnt, out_1, o_size, wg_size, tx_ts);
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+
+    for (size_t chunk_leaf_cnt_ : { chunk_leaf_cnt, leaf_cnt }) {
+      q.memset(out_1, 0, o_size).wait();
+      merklize_file_staged<H>(
+        q, f, leaf_cnt, out_1, o_size, chunk_leaf_cnt_, wg_size, tx_ts);
+
+      for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+        assert(out_0[i] == out_1[i]);
+      }
+    }
+
+    word_t root[H::NODE_WORDS];
+    merklize_file_stream<H>(
+      q, f, leaf_cnt, root, chunk_leaf_cnt, wg_size, tx_ts);
+
+    assert(node::equal<H>(out_0 + H::NODE_WORDS, root));
+  }
+
+  std::remove(path);
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "merklize_hybrid.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes same set of random leaf nodes, using both `merklize` ( all levels
+// computed on accelerator ) & `merklize_hybrid` ( upper levels computed on host
+// ) and asserts that all intermediate nodes are same
+template<typename H>
+void
+test_merklize_hybrid(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size =
+    (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  // cutover level is expected to be lowest level having at max
+  // `host_node_cnt` -many nodes, though level 1 is never computed on host
+  const size_t host_node_cnts[] = { 0, 1, 7, 64, leaf_cnt >> 1, leaf_cnt };
+  const size_t cutover_lvls[] = { 11, 10, 8, 4, 2, 2 };
+
+  for (size_t i = 0; i < sizeof(host_node_cnts) / sizeof(size_t); i++) {
+    size_t cutover_lvl = 0;
+
+    q.memset(out_1, 0, o_size).wait();
+    merklize_hybrid<H>(q,
+                        in,
+                        i_size,
+                        leaf_cnt,
+                        out_1,
+                        o_size,
+                        leaf_cnt - 1,
+                        wg_size,
+                        host_node_cnts[i],
+                        &cutover_lvl);
+
+    assert(cutover_lvl == cutover_lvls[i]);
+
+    const sycl::uchar* out_0_ = reinterpret_cast<sycl::uchar*>(out_0);
+    const sycl::uchar* out_1_ = reinterpret_cast<sycl::uchar*>(out_1);
+
+    for (size_t j = 0; j < o_size; j++) {
+      assert(out_0_[j] == out_1_[j]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "merklize_arbitrary.hpp"
+#include "merklize_incremental.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <thread>
+
+// Computes root of binary merkle tree with first `leaf_cnt` -many leaf nodes
+// of `in`, using `merklize_arbitrary` ( with odd nodes promoted ), writing it
+// to NODE_WORDS -many words of `root`
+template<typename H>
+void
+arbitrary_root(sycl::queue& q,
+               const typename H::word_t* const in,
+               size_t leaf_cnt,
+               typename H::word_t* const root)
+{
+  using word_t = typename H::word_t;
+
+  const size_t itmd_cnt = intermediate_cnt(leaf_cnt);
+  const size_t i_size =
+    ((leaf_cnt + 1) >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+  const size_t o_size = (itmd_cnt + 1) * H::NODE_LEN_BYTES;
+
+  word_t* out = (word_t*)sycl::malloc_shared(o_size, q);
+
+  merklize_arbitrary<H>(q,
+                        in,
+                        i_size,
+                        leaf_cnt,
+                        out,
+                        o_size,
+                        itmd_cnt,
+                        1 << 5,
+                        odd_node_policy::promote);
+
+  for (size_t i = 0; i < H::NODE_WORDS; i++) {
+    root[i] = out[H::NODE_WORDS + i];
+  }
+
+  sycl::free(out, q);
+}
+
+// Appends random leaf nodes to incremental binary merkle tree, one by one & in
+// batches ( of different sizes, so that both host & accelerator paths are
+// taken ), asserting that root of tree after each append is same as what
+// `merklize_arbitrary` computes, when all appended leaf nodes are merklized at
+// once; then same leaf node is appended by multiple concurrent producers
+// ( so that order of appends doesn't matter ) and final root is checked
+template<typename H>
+void
+test_merklize_incremental(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1000;
+  constexpr size_t i_size =
+    ((leaf_cnt + 1) >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+
+  // # -of leaf nodes appended in each step, where 1 means single leaf node
+  // append & others are batch appends
+  constexpr size_t steps[] = { 1, 1, 1, 5, 37, 1, 64, 300, 1, 17, 128, 444 };
+
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+
+  fill_random(in, i_size);
+
+  {
+    incremental_tree<H> tree{ q, 1 << 3, 1 << 5 };
+
+    word_t root_0[H::NODE_WORDS];
+    word_t root_1[H::NODE_WORDS];
+
+    assert(tree.root(root_0) == 0);
+
+    size_t appended = 0;
+    for (size_t step : steps) {
+      if (step == 1) {
+        word_t leaf[H::NODE_WORDS];
+
+        node::leaf_at<H>(in, appended, leaf);
+        tree.append(leaf);
+      } else {
+        // leaf nodes of batch must start at pair boundary, so when batch
+        // starts at odd leaf index, it's repacked
+        std::vector<word_t> batch(((step + 1) >> 1) * H::LEAF_PAIR_WORDS, 0);
+        for (size_t i = 0; i < step; i++) {
+          word_t leaf[H::NODE_WORDS];
+
+          node::leaf_at<H>(in, appended + i, leaf);
+          node::put_leaf_at<H>(leaf, i, batch.data());
+        }
+
+        tree.append_batch(batch.data(), step);
+      }
+      appended += step;
+
+      assert(tree.size() == appended);
+      assert(tree.root(root_0) == appended);
+
+      if (appended == 1) {
+        node::leaf_at<H>(in, 0, root_1);
+      } else {
+        arbitrary_root<H>(q, in, appended, root_1);
+      }
+
+      for (size_t i = 0; i < H::NODE_WORDS; i++) {
+        assert(root_0[i] == root_1[i]);
+      }
+    }
+  }
+
+  {
+    constexpr size_t producer_cnt = 4;
+    constexpr size_t batch_cnt = 8;
+    constexpr size_t batch_size = 37;
+
+    // all leaf nodes of batch are same as first leaf node of `in`
+    std::vector<word_t> batch(((batch_size + 1) >> 1) * H::LEAF_PAIR_WORDS);
+    {
+      word_t leaf[H::NODE_WORDS];
+      node::leaf_at<H>(in, 0, leaf);
+
+      for (size_t i = 0; i < batch_size; i++) {
+        node::put_leaf_at<H>(leaf, i, batch.data());
+      }
+    }
+
+    incremental_tree<H> tree{ q, 1 << 3, 1 << 5 };
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producer_cnt; p++) {
+      producers.emplace_back([&]() {
+        for (size_t b = 0; b < batch_cnt; b++) {
+          tree.append_batch(batch.data(), batch_size);
+        }
+      });
+    }
+    for (auto& p : producers) {
+      p.join();
+    }
+
+    constexpr size_t total = producer_cnt * batch_cnt * batch_size;
+
+    // same leaf node, repeated `total` times, as `merklize_arbitrary` input
+    word_t* in_ = (word_t*)sycl::malloc_shared(
+      ((total + 1) >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t), q);
+    for (size_t i = 0; i < ((total + 1) >> 1); i++) {
+      std::copy(batch.begin(),
+                batch.begin() + H::LEAF_PAIR_WORDS,
+                in_ + i * H::LEAF_PAIR_WORDS);
+    }
+
+    word_t root_0[H::NODE_WORDS];
+    word_t root_1[H::NODE_WORDS];
+
+    assert(tree.root(root_0) == total);
+    arbitrary_root<H>(q, in_, total, root_1);
+
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      assert(root_0[i] == root_1[i]);
+    }
+
+    sycl::free(in_, q);
+  }
+
+  sycl::free(in, q);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "merklize_interleaved.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes random leaf nodes using Keccak-256, keeping intermediate nodes in
+// bit interleaved form, asserting that root & all exported intermediate nodes
+// are same as `merklize` computes, using standard form
+void
+test_merklize_interleaved(sycl::queue& q)
+{
+  using H = hasher::keccak_256_u32;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // acquire resources
+  sycl::uchar* in = (sycl::uchar*)sycl::malloc_shared(i_size, q);
+  sycl::uchar* out_0 = (sycl::uchar*)sycl::malloc_shared(o_size, q);
+  sycl::uint* out_1 = (sycl::uint*)sycl::malloc_shared(o_size, q);
+  sycl::uchar* out_2 = (sycl::uchar*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  sycl::uchar root[H::NODE_LEN_BYTES];
+
+  q.memset(out_1, 0, o_size).wait();
+  merklize_interleaved(
+    q, in, i_size, leaf_cnt, out_1, o_size, leaf_cnt - 1, wg_size, root);
+
+  assert(node::equal<H>(out_0 + H::NODE_WORDS, root));
+
+  // all intermediate nodes, except root, are still in bit interleaved form
+  {
+    const sycl::uchar* out_1_ = reinterpret_cast<const sycl::uchar*>(out_1);
+
+    bool eq = true;
+    for (size_t i = 2 * H::NODE_LEN_BYTES; i < o_size; i++) {
+      eq &= out_0[i] == out_1_[i];
+    }
+    assert(!eq);
+  }
+
+  q.memset(out_2, 0, o_size).wait();
+  export_interleaved_nodes(
+    q, out_1, 1, leaf_cnt - 1, out_2 + H::NODE_LEN_BYTES, wg_size, {})
+    .wait();
+
+  for (size_t i = 0; i < o_size; i++) {
+    assert(out_0[i] == out_2[i]);
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+  sycl::free(out_2, q);
+}
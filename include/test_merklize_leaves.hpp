@@ -0,0 +1,218 @@
+#pragma once
+#include "merklize_leaves.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <string_view>
+#include <vector>
+
+// Writes DIGEST_LEN_BYTES -many bytes of node ( NODE_WORDS -many words ), in
+// order they appear in digest produced by standard implementation of hash
+// function
+template<typename H>
+void
+node_to_bytes(const typename H::word_t* const node, sycl::uchar* const out)
+{
+  if constexpr (sizeof(typename H::word_t) == 1 || hasher::has_lane_words<H>) {
+    const sycl::uchar* node_ = reinterpret_cast<const sycl::uchar*>(node);
+
+    for (size_t i = 0; i < H::DIGEST_LEN_BYTES; i++) {
+      out[i] = node_[i];
+    }
+  } else {
+    constexpr size_t w_len = sizeof(typename H::word_t);
+    sycl::uchar tmp[H::NODE_LEN_BYTES];
+
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      from_words_to_be_bytes(node[i], tmp + i * w_len);
+    }
+    for (size_t i = 0; i < H::DIGEST_LEN_BYTES; i++) {
+      out[i] = tmp[i];
+    }
+  }
+}
+
+// Digest of concatenated digests of messages prepared in
+// `test_merklize_leaves`, obtained by executing following snippet in python3
+// shell ( keccak-256 is computed using pure python implementation of
+// keccak-f[1600], as it's not available in hashlib )
+//
+// >>> import hashlib
+// >>> lens = [0, 3, 55, 56, 64, 111, 112, 119, 128, 200, 4096]
+// >>> msg = lambda l: b'abc' if l == 3 else bytes(i % 251 for i in range(l))
+// >>> h = lambda m: hashlib.new('sha512_224', m).digest()
+// >>> h(b''.join(h(msg(l)) for l in lens)).hex()
+std::string_view
+leaf_hashing_kat(std::string_view id)
+{
+  if (id == "sha1") {
+    return "95891cd61afaf1a037558eacea6c06513947a8bf";
+  }
+  if (id == "sha2_224") {
+    return "0ca7a2b54d4fc72be5de73d76ff3f3d27ad5167174f888aecdaf2f1d";
+  }
+  if (id == "sha2_256") {
+    return "04f8f4ebb2a13ccd0c488e8c52d75ec9615450be403e59e880edd9125646753e";
+  }
+  if (id == "sha2_384") {
+    return "c4e1a4a9a02df499d667ea164f08b87be3bfc395be9e24ed876af6c87715279e"
+           "db1641671b1e4a21a55c9896de048d92";
+  }
+  if (id == "sha2_512") {
+    return "03f9b23559398c6a6c6f6836e436b8592fc6eee1ff832d99c413fdaf22cdabd5"
+           "fa140d57cfa00fec4bde3c9a6e2cf6a16dc7722e61ff81dc4c7e09972065ab6e";
+  }
+  if (id == "sha2_512_224") {
+    return "034a534f43137f5223da7b683b637fb017ecb315c429a52c54396b57";
+  }
+  if (id == "sha2_512_256") {
+    return "06f51d3cb9b6bad4742a483181c4bab1f1b4552f7fdf25d3fbc7d85de075598d";
+  }
+  if (id == "sha3_224") {
+    return "dd330221801a65ff58387528750e9e605a9f9de83cc87038dbace0e0";
+  }
+  if (id == "sha3_256") {
+    return "dbf837051f87ffef740b4e77a7b5916fe0c25ea76a952e19e80901cf865b85a8";
+  }
+  if (id == "sha3_384") {
+    return "75368f13b4acbde6f46608f86e9de70682765fa67bad58f03320b2c4a4f67090"
+           "726a2c5287b7985f4bbf7472fb93edf8";
+  }
+  if (id == "sha3_512") {
+    return "a81a20dab1d2006fa5c711447a291c69d561f3c4dac8bcbadd61cc47e31cd86e"
+           "0a52bf25e14354263727060cfd2561190c0547db0bbf1a623c9208bae3c6c22d";
+  }
+
+  // both keccak-256 hasher policies
+  return "2c51532e9ce46f166e16bcd0578f5a889b9061725f3357eea720ce64a26d69a8";
+}
+
+// Tests `hash_message` of hasher policy against known answers, for messages
+// crossing padding boundaries of all variants, checks that it agrees with
+// 2-to-1 hash function, when fed with two consecutive leaf nodes, and then
+// hashes ragged raw leaf data on accelerator, using `hash_leaf_data` &
+// `merklize_raw`, asserting that results are same as hashing on host
+template<typename H>
+void
+test_merklize_leaves(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t lens[] = {
+    0, 3, 55, 56, 64, 111, 112, 119, 128, 200, 4096
+  };
+
+  // known answer test
+  {
+    std::vector<sycl::uchar> cat;
+    word_t node[H::NODE_WORDS];
+    sycl::uchar digest[H::DIGEST_LEN_BYTES];
+
+    for (size_t len : lens) {
+      std::vector<sycl::uchar> msg(len);
+      for (size_t i = 0; i < len; i++) {
+        msg[i] = len == 3 ? static_cast<sycl::uchar>('a' + i)
+                          : static_cast<sycl::uchar>(i % 251);
+      }
+
+      H::hash_message(msg.data(), len, node);
+      node_to_bytes<H>(node, digest);
+      cat.insert(cat.end(), digest, digest + H::DIGEST_LEN_BYTES);
+    }
+
+    H::hash_message(cat.data(), cat.size(), node);
+    node_to_bytes<H>(node, digest);
+
+    const std::string_view expected = leaf_hashing_kat(H::ID);
+    assert(expected.size() == H::DIGEST_LEN_BYTES << 1);
+
+    constexpr char hex[] = "0123456789abcdef";
+    for (size_t i = 0; i < H::DIGEST_LEN_BYTES; i++) {
+      assert(expected[i << 1] == hex[digest[i] >> 4]);
+      assert(expected[(i << 1) + 1] == hex[digest[i] & 0xf]);
+    }
+  }
+
+  // 2-to-1 hash function is same as hashing two consecutive leaf nodes
+  {
+    word_t pair[H::LEAF_PAIR_WORDS];
+    fill_random(pair, sizeof(pair));
+
+    sycl::uchar msg[H::DIGEST_LEN_BYTES << 1];
+    word_t leaf[H::NODE_WORDS];
+    for (size_t j = 0; j < 2; j++) {
+      node::leaf_at<H>(pair, j, leaf);
+      node_to_bytes<H>(leaf, msg + j * H::DIGEST_LEN_BYTES);
+    }
+
+    word_t out_0[H::NODE_WORDS];
+    word_t out_1[H::NODE_WORDS];
+
+    H::hash(pair, out_0);
+    H::hash_message(msg, sizeof(msg), out_1);
+
+    assert(node::equal<H>(out_0, out_1));
+  }
+
+  // ragged raw leaf data, hashed on accelerator
+  {
+    constexpr size_t leaf_cnt = 1 << 8;
+    constexpr size_t wg_size = 1 << 5;
+    constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+    constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+    std::vector<size_t> offs(leaf_cnt + 1, 0);
+    for (size_t i = 0; i < leaf_cnt; i++) {
+      offs[i + 1] = offs[i] + (i * 37) % 300;
+    }
+
+    const size_t d_size = offs[leaf_cnt];
+
+    // acquire resources
+    sycl::uchar* data = (sycl::uchar*)sycl::malloc_shared(d_size, q);
+    word_t* in_0 = (word_t*)sycl::malloc_shared(i_size, q);
+    word_t* in_1 = (word_t*)sycl::malloc_shared(i_size, q);
+    word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+    word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+    fill_random(data, d_size);
+
+    // leaf nodes computed on host, where last leaf node is zero, as only
+    // (leaf_cnt - 1) -many records are hashed on accelerator
+    for (size_t i = 0; i < leaf_cnt; i++) {
+      word_t leaf[H::NODE_WORDS] = {};
+      if (i + 1 < leaf_cnt) {
+        H::hash_message(data + offs[i], offs[i + 1] - offs[i], leaf);
+      }
+      node::put_leaf_at<H>(leaf, i, in_0);
+    }
+
+    hash_leaf_data<H>(
+      q, data, offs.data(), leaf_cnt - 1, in_1, i_size, wg_size);
+
+    for (size_t i = 0; i < i_size / sizeof(word_t); i++) {
+      assert(in_0[i] == in_1[i]);
+    }
+
+    // all records, merklized on accelerator
+    for (size_t i = 0; i < leaf_cnt; i++) {
+      word_t leaf[H::NODE_WORDS];
+      H::hash_message(data + offs[i], offs[i + 1] - offs[i], leaf);
+      node::put_leaf_at<H>(leaf, i, in_0);
+    }
+
+    reference_merklize<H>(q, in_0, leaf_cnt, out_0);
+    merklize_raw<H>(q, data, offs.data(), leaf_cnt, out_1, o_size, wg_size);
+
+    for (size_t i = 1; i < leaf_cnt; i++) {
+      assert(node::equal<H>(out_0 + i * H::NODE_WORDS,
+                            out_1 + i * H::NODE_WORDS));
+    }
+
+    // ensure resources are deallocated
+    sycl::free(data, q);
+    sycl::free(in_0, q);
+    sycl::free(in_1, q);
+    sycl::free(out_0, q);
+    sycl::free(out_1, q);
+  }
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "merklize_materialize.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes random leaf nodes using `merklize_materialize`, with all
+// materialization modes, asserting that materialized nodes are same as those
+// living at same index of `merklize` output
+template<typename H>
+void
+test_merklize_materialize(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t lvl_cnt = 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // # -of top levels to be kept, when materializing merkle cap
+  constexpr size_t cap_lvl_cnts[] = { 1, 2, 4, lvl_cnt - 1, lvl_cnt };
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* in_ = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  // full tree
+  {
+    q.memset(out_1, 0, o_size).wait();
+    merklize_materialize<H>(q,
+                            in,
+                            i_size,
+                            leaf_cnt,
+                            materialization::full,
+                            0,
+                            out_1,
+                            o_size,
+                            wg_size);
+
+    for (size_t i = 0; i < leaf_cnt * H::NODE_WORDS; i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  // merkle cap, where leaf nodes may be overwritten
+  for (size_t cap_lvl_cnt : cap_lvl_cnts) {
+    const size_t cap_size =
+      materialized_size<H>(materialization::cap, leaf_cnt, cap_lvl_cnt);
+    assert(cap_size == (1ul << cap_lvl_cnt) * H::NODE_LEN_BYTES);
+
+    q.memcpy(in_, in, i_size).wait();
+    q.memset(out_1, 0, cap_size).wait();
+
+    merklize_materialize<H>(q,
+                            in_,
+                            i_size,
+                            leaf_cnt,
+                            materialization::cap,
+                            cap_lvl_cnt,
+                            out_1,
+                            cap_size,
+                            wg_size);
+
+    for (size_t i = 0; i < cap_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  // cap wider than tree, however wide, is whole tree
+  for (size_t cap_lvl_cnt : { lvl_cnt + 1, 63ul, 64ul, 1000ul }) {
+    assert(materialized_size<H>(materialization::cap, leaf_cnt, cap_lvl_cnt) ==
+           o_size);
+  }
+
+  // only root, where leaf nodes may be overwritten
+  {
+    const size_t root_size =
+      materialized_size<H>(materialization::root, leaf_cnt, 0);
+    assert(root_size == H::NODE_LEN_BYTES);
+
+    q.memcpy(in_, in, i_size).wait();
+
+    merklize_materialize<H>(q,
+                            in_,
+                            i_size,
+                            leaf_cnt,
+                            materialization::root,
+                            0,
+                            out_1,
+                            root_size,
+                            wg_size);
+
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      assert(out_0[H::NODE_WORDS + i] == out_1[i]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(in_, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "merklize_numa.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes random leaf nodes, living on host memory, across NUMA domains of
+// device ( or whole device, when it can't be partitioned ) & also across four
+// queues targeting same device, asserting that intermediate nodes are same as
+// `merklize` computes, including when there're fewer leaf nodes than domains
+//
+// Host buffers are allocated from context of queues `merklize_numa` runs on,
+// or they're pageable memory
+template<typename H>
+void
+test_merklize_numa(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_host(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  sycl::cl_ulong tx_ts[2];
+
+  {
+    std::vector<sycl::queue> qs = numa_queues(q.get_device());
+    assert(!qs.empty());
+
+    // domains share a context, which is not same as `q`'s
+    word_t* in_h = (word_t*)sycl::malloc_host(i_size, qs[0]);
+    word_t* out_h = (word_t*)sycl::malloc_host(o_size, qs[0]);
+
+    std::copy(in, in + i_size / sizeof(word_t), in_h);
+    std::fill(out_h, out_h + o_size / sizeof(word_t), 0);
+    merklize_numa<H>(
+      qs, in_h, i_size, leaf_cnt, out_h, o_size, wg_size, tx_ts);
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_h[i]);
+    }
+
+    sycl::free(in_h, qs[0]);
+    sycl::free(out_h, qs[0]);
+  }
+
+  // copies of `q`, sharing its context, so `q`'s USM can be used
+  std::vector<sycl::queue> qs(4, q);
+
+  {
+    std::fill(out_1, out_1 + o_size / sizeof(word_t), 0);
+    merklize_numa<H>(qs, in, i_size, leaf_cnt, out_1, o_size, wg_size, tx_ts);
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  {
+    // pageable memory, which can be used with queues of any context
+    std::vector<word_t> in_p(in, in + i_size / sizeof(word_t));
+    std::vector<word_t> out_p(o_size / sizeof(word_t), 0);
+
+    merklize_numa<H>(
+      qs, in_p.data(), i_size, leaf_cnt, out_p.data(), o_size, wg_size, tx_ts);
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_p[i]);
+    }
+  }
+
+  {
+    // two leaf nodes, so only one of four domains is used
+    constexpr size_t i_size_ = 2 * H::DIGEST_LEN_BYTES;
+    constexpr size_t o_size_ = 2 * H::NODE_LEN_BYTES;
+
+    reference_merklize<H>(q, in, 2, out_0);
+
+    std::fill(out_1, out_1 + o_size_ / sizeof(word_t), 0);
+    merklize_numa<H>(qs, in, i_size_, 2, out_1, o_size_, wg_size, tx_ts);
+
+    assert(node::equal<H>(out_0 + H::NODE_WORDS, out_1 + H::NODE_WORDS));
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "merklize_persistent.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes same set of random leaf nodes, using both `merklize` ( one level
+// per kernel dispatch ) & `merklize_persistent` ( single kernel dispatch ) and
+// asserts that all intermediate nodes are same
+template<typename H>
+void
+test_merklize_persistent(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+
+  constexpr size_t i_size =
+    (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  // work-group size shouldn't have any effect on computed tree
+  for (size_t wg_size = 1; wg_size <= (leaf_cnt >> 1); wg_size <<= 2) {
+    q.memset(out_1, 0, o_size).wait();
+    merklize_persistent<H>(
+      q, in, i_size, leaf_cnt, out_1, o_size, leaf_cnt - 1, wg_size);
+
+    const sycl::uchar* out_0_ = reinterpret_cast<sycl::uchar*>(out_0);
+    const sycl::uchar* out_1_ = reinterpret_cast<sycl::uchar*>(out_1);
+
+    for (size_t i = 0; i < o_size; i++) {
+      assert(out_0_[i] == out_1_[i]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "merklize_pipelined.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes random leaf nodes using `merklize_pipelined`, while uploading them
+// in different many segments, asserting that all intermediate nodes are same
+// as `merklize` computes, when leaf nodes are uploaded at once, while reported
+// hidden transfer time never exceeds total transfer time
+template<typename H>
+void
+test_merklize_pipelined(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // when segment has fewer leaf node pairs than work-group size, smaller
+  // work-groups are dispatched
+  constexpr size_t seg_cnts[] = { 1, 2, 8, 64, leaf_cnt >> 1 };
+
+  // acquire resources
+  word_t* in_h = (word_t*)sycl::malloc_host(i_size, q);
+  word_t* in = (word_t*)sycl::malloc_device(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in_h, i_size);
+
+  q.memcpy(in, in_h, i_size).wait();
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  for (size_t seg_cnt : seg_cnts) {
+    sycl::cl_ulong tx_ts[2];
+
+    q.memset(in, 0, i_size).wait();
+    q.memset(out_1, 0, o_size).wait();
+
+    merklize_pipelined<H>(q,
+                          in_h,
+                          in,
+                          i_size,
+                          leaf_cnt,
+                          out_1,
+                          o_size,
+                          leaf_cnt - 1,
+                          wg_size,
+                          seg_cnt,
+                          tx_ts);
+
+    // hidden portion of transfer time can't exceed total transfer time
+    assert(tx_ts[1] <= tx_ts[0]);
+
+    for (size_t i = 0; i < leaf_cnt * H::NODE_WORDS; i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in_h, q);
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "merklize_proof.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <map>
+
+// Merklizes random leaf nodes using `merklize`, then extracts inclusion proofs
+// & multiproofs of chosen leaf nodes, asserting that root of tree can be
+// recomputed ( on host ) using them, while each multiproof holds only those
+// nodes which can't be derived from requested leaf nodes
+template<typename H>
+void
+test_merklize_proof(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t depth = 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out);
+
+  const word_t* root = out + H::NODE_WORDS;
+
+  auto hash_pair = [](const word_t* a, const word_t* b, word_t* o) {
+    word_t in_words[H::NODE_WORDS << 1];
+
+    std::copy(a, a + H::NODE_WORDS, in_words);
+    std::copy(b, b + H::NODE_WORDS, in_words + H::NODE_WORDS);
+
+    node::hash_nodes<H>(in_words, o);
+  };
+
+  // inclusion proofs
+  {
+    const size_t leaf_idxs[] = { 0, 1, 2, 511, 512, 777, leaf_cnt - 1, 1 };
+    constexpr size_t idx_cnt = sizeof(leaf_idxs) / sizeof(size_t);
+
+    std::vector<word_t> proofs(idx_cnt * depth * H::NODE_WORDS);
+    merkle_proofs<H>(
+      q, in, out, leaf_cnt, leaf_idxs, idx_cnt, proofs.data(), wg_size);
+
+    for (size_t i = 0; i < idx_cnt; i++) {
+      const word_t* proof = proofs.data() + i * depth * H::NODE_WORDS;
+
+      word_t acc[H::NODE_WORDS];
+      node::leaf_at<H>(in, leaf_idxs[i], acc);
+
+      for (size_t l = 0; l < depth; l++) {
+        const word_t* sibling = proof + l * H::NODE_WORDS;
+
+        if (((leaf_idxs[i] >> l) & 1) == 1) {
+          hash_pair(sibling, acc, acc);
+        } else {
+          hash_pair(acc, sibling, acc);
+        }
+      }
+
+      for (size_t j = 0; j < H::NODE_WORDS; j++) {
+        assert(acc[j] == root[j]);
+      }
+    }
+  }
+
+  // multiproofs, along with expected # -of nodes in each of them
+  {
+    const std::vector<size_t> leaf_idxs[] = {
+      { 5 },
+      { 0, 1 },
+      { 1, 0, 1 },
+      { 0, leaf_cnt - 1 },
+      { 3, 4, 100, 101, 102, 900 },
+    };
+    const size_t proof_lens[] = { depth, depth - 1, depth - 1, 2 * depth - 2 };
+
+    for (size_t t = 0; t < sizeof(leaf_idxs) / sizeof(leaf_idxs[0]); t++) {
+      std::vector<size_t> slots;
+      std::vector<word_t> proof;
+
+      merkle_multiproof<H>(q,
+                           in,
+                           out,
+                           leaf_cnt,
+                           leaf_idxs[t].data(),
+                           leaf_idxs[t].size(),
+                           &slots,
+                           &proof,
+                           wg_size);
+
+      if (t < sizeof(proof_lens) / sizeof(size_t)) {
+        assert(slots.size() == proof_lens[t]);
+      }
+
+      // all known nodes, keyed by implicit heap index
+      std::map<size_t, std::vector<word_t>> known;
+
+      for (size_t leaf_idx : leaf_idxs[t]) {
+        std::vector<word_t> leaf(H::NODE_WORDS);
+        node::leaf_at<H>(in, leaf_idx, leaf.data());
+        known[leaf_cnt + leaf_idx] = leaf;
+      }
+      for (size_t i = 0; i < slots.size(); i++) {
+        // none of proof nodes should be derivable from others
+        assert(known.find(slots[i]) == known.end());
+
+        known[slots[i]] = std::vector<word_t>(
+          proof.begin() + i * H::NODE_WORDS,
+          proof.begin() + (i + 1) * H::NODE_WORDS);
+      }
+
+      // deepest node always has largest heap index, so keep merging it with
+      // its sibling, until only root is left
+      while (known.rbegin()->first > 1) {
+        const size_t n_idx = known.rbegin()->first;
+        const size_t l_idx = n_idx & ~1ul;
+
+        assert(known.count(l_idx) == 1 && known.count(l_idx + 1) == 1);
+
+        std::vector<word_t> parent(H::NODE_WORDS);
+        hash_pair(known[l_idx].data(), known[l_idx + 1].data(), parent.data());
+
+        // parent must not be in proof, as it's derivable
+        assert(known.count(l_idx >> 1) == 0);
+
+        known.erase(l_idx);
+        known.erase(l_idx + 1);
+        known[l_idx >> 1] = parent;
+      }
+
+      for (size_t j = 0; j < H::NODE_WORDS; j++) {
+        assert(known[1][j] == root[j]);
+      }
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out, q);
+}
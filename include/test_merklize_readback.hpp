@@ -0,0 +1,60 @@
+#pragma once
+#include "merklize_readback.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes random leaf nodes using `merklize_readback`, with different
+// work-group sizes ( which decide how many levels are copied back separately
+// ), asserting that intermediate nodes copied back to host are same as
+// `merklize` computes
+template<typename H>
+void
+test_merklize_readback(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  constexpr size_t wg_sizes[] = { 1, 1 << 5, leaf_cnt >> 1 };
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_device(o_size, q);
+  word_t* out_h = (word_t*)sycl::malloc_host(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out_0);
+
+  for (size_t wg_size : wg_sizes) {
+    sycl::cl_ulong tx_ts[2];
+
+    q.memset(out_1, 0, o_size).wait();
+    std::fill(out_h, out_h + leaf_cnt * H::NODE_WORDS, 0);
+
+    merklize_readback<H>(q,
+                         in,
+                         i_size,
+                         leaf_cnt,
+                         out_1,
+                         o_size,
+                         leaf_cnt - 1,
+                         wg_size,
+                         out_h,
+                         tx_ts);
+
+    for (size_t i = 0; i < leaf_cnt * H::NODE_WORDS; i++) {
+      assert(out_0[i] == out_h[i]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+  sycl::free(out_h, q);
+}
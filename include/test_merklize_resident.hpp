@@ -0,0 +1,98 @@
+#pragma once
+#include "merklize_resident.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <random>
+
+// Keeps binary merkle tree of random leaf nodes resident on accelerator and
+// updates few of its leaf nodes ( including repeated leaf indices ) in multiple
+// rounds, asserting that after each round all nodes are same as what
+// `merklize` computes, when all leaf nodes are merklized again
+template<typename H>
+void
+test_merklize_resident(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // # -of leaf nodes updated in each round
+  constexpr size_t upd_cnts[] = { 1, 2, 7, 100, leaf_cnt, 3 };
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* expected = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* computed = (word_t*)sycl::malloc_shared(o_size << 1, q);
+
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> idx_dis(0, leaf_cnt - 1);
+
+  fill_random(in, i_size);
+
+  resident_tree<H> tree{ q, in, leaf_cnt, wg_size };
+  assert(tree.size() == leaf_cnt);
+
+  for (size_t upd_cnt : upd_cnts) {
+    std::vector<size_t> indices(upd_cnt);
+    std::vector<word_t> leaves(upd_cnt * H::NODE_WORDS);
+
+    for (size_t i = 0; i < upd_cnt; i++) {
+      // every other update touches same leaf as previous one, so that last
+      // update should win
+      indices[i] = (i & 1) == 1 ? indices[i - 1] : idx_dis(gen);
+
+      word_t leaf[H::NODE_WORDS];
+      fill_random(leaf, sizeof(leaf));
+
+      // SHA2-512/224 leaf node is 28 -bytes, placed in 32 -bytes node slot
+      if constexpr (H::NODE_LEN_BYTES != H::DIGEST_LEN_BYTES) {
+        leaf[H::NODE_WORDS - 1] &= 0xffffffff00000000ul;
+      }
+
+      std::copy(leaf, leaf + H::NODE_WORDS, leaves.data() + i * H::NODE_WORDS);
+    }
+
+    tree.update(indices.data(), leaves.data(), upd_cnt);
+
+    // apply same updates on host copy of leaf nodes, in order
+    for (size_t i = 0; i < upd_cnt; i++) {
+      node::put_leaf_at<H>(leaves.data() + i * H::NODE_WORDS, indices[i], in);
+    }
+
+    reference_merklize<H>(q, in, leaf_cnt, expected);
+
+    q.memcpy(computed, tree.data(), o_size << 1).wait();
+
+    // all intermediate nodes
+    for (size_t i = H::NODE_WORDS; i < leaf_cnt * H::NODE_WORDS; i++) {
+      assert(computed[i] == expected[i]);
+    }
+
+    // all leaf nodes
+    for (size_t i = 0; i < leaf_cnt; i++) {
+      word_t leaf[H::NODE_WORDS];
+      node::leaf_at<H>(in, i, leaf);
+
+      for (size_t j = 0; j < H::NODE_WORDS; j++) {
+        assert(computed[(leaf_cnt + i) * H::NODE_WORDS + j] == leaf[j]);
+      }
+    }
+
+    word_t root[H::NODE_WORDS];
+    tree.root(root);
+
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      assert(root[i] == expected[H::NODE_WORDS + i]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(expected, q);
+  sycl::free(computed, q);
+}
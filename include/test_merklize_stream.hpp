@@ -0,0 +1,52 @@
+#pragma once
+#include "merklize_stream.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+
+// Merklizes random leaf nodes out-of-core, using `merklize_stream`, with
+// different chunk sizes, asserting that computed root is same as `merklize`
+// computes, when whole tree is merklized at once
+template<typename H>
+void
+test_merklize_stream(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // 0 denotes chunk size is chosen based on global memory size of device
+  constexpr size_t chunk_leaf_cnts[] = { 2, 4, 64, 256, leaf_cnt, 0 };
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_host(i_size, q);
+  word_t* out = (word_t*)sycl::malloc_shared(o_size, q);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out);
+
+  for (size_t chunk_leaf_cnt : chunk_leaf_cnts) {
+    word_t root[H::NODE_WORDS];
+    sycl::cl_ulong tx_ts[2];
+
+    merklize_stream<H>(
+      q, in, i_size, leaf_cnt, root, chunk_leaf_cnt, wg_size, tx_ts);
+
+    for (size_t i = 0; i < H::NODE_WORDS; i++) {
+      assert(root[i] == out[H::NODE_WORDS + i]);
+    }
+  }
+
+  // chunk size chosen for device must be power of 2
+  const size_t chunk_leaf_cnt = stream_chunk_leaf_cnt<H>(q);
+  assert(chunk_leaf_cnt >= 2);
+  assert((chunk_leaf_cnt & (chunk_leaf_cnt - 1)) == 0);
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out, q);
+}
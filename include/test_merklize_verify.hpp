@@ -0,0 +1,102 @@
+#pragma once
+#include "merklize_proof.hpp"
+#include "merklize_verify.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <random>
+
+// Merklizes random leaf nodes using `merklize`, extracts inclusion proofs of
+// many leaf nodes using `merkle_proofs` and verifies them in batch, using
+// `verify_proofs`, asserting that only untampered ones pass
+template<typename H>
+void
+test_merklize_verify(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t depth = 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  // # -of proofs to be verified in batch, not multiple of 32
+  constexpr size_t proof_cnt = 100;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+  constexpr size_t node_size = proof_cnt * H::NODE_LEN_BYTES;
+  constexpr size_t proof_size = node_size * depth;
+  constexpr size_t idx_size = proof_cnt * sizeof(size_t);
+  constexpr size_t bm_size = ((proof_cnt + 31) >> 5) * sizeof(sycl::uint);
+
+  // acquire resources
+  word_t* in = (word_t*)sycl::malloc_shared(i_size, q);
+  word_t* out = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* leaves = (word_t*)sycl::malloc_shared(node_size, q);
+  word_t* proofs = (word_t*)sycl::malloc_shared(proof_size, q);
+  word_t* roots = (word_t*)sycl::malloc_shared(node_size, q);
+  size_t* leaf_idxs = (size_t*)sycl::malloc_shared(idx_size, q);
+  sycl::uint* bitmap = (sycl::uint*)sycl::malloc_shared(bm_size, q);
+
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> idx_dis(0, leaf_cnt - 1);
+
+  fill_random(in, i_size);
+
+  reference_merklize<H>(q, in, leaf_cnt, out);
+
+  for (size_t i = 0; i < proof_cnt; i++) {
+    leaf_idxs[i] = idx_dis(gen);
+
+    node::leaf_at<H>(in, leaf_idxs[i], leaves + i * H::NODE_WORDS);
+    std::copy(out + H::NODE_WORDS,
+              out + 2 * H::NODE_WORDS,
+              roots + i * H::NODE_WORDS);
+  }
+
+  merkle_proofs<H>(q, in, out, leaf_cnt, leaf_idxs, proof_cnt, proofs, wg_size);
+
+  auto passed = [&](size_t i) { return ((bitmap[i >> 5] >> (i & 31)) & 1); };
+
+  // all proofs must pass
+  verify_proofs<H>(
+    q, leaves, leaf_idxs, proofs, roots, proof_cnt, depth, bitmap, wg_size);
+
+  for (size_t i = 0; i < proof_cnt; i++) {
+    assert(passed(i) == 1);
+  }
+
+  // tamper with some of them, each one in a different way
+  constexpr size_t bad_proof = 3;
+  constexpr size_t bad_root = 31;
+  constexpr size_t bad_leaf = 32;
+  constexpr size_t bad_idx = 64;
+  constexpr size_t big_idx = proof_cnt - 1;
+
+  proofs[(bad_proof * depth + depth - 1) * H::NODE_WORDS] ^= 1;
+  roots[bad_root * H::NODE_WORDS] ^= 1;
+  leaves[bad_leaf * H::NODE_WORDS] ^= 1;
+  leaf_idxs[bad_idx] ^= 1;
+  leaf_idxs[big_idx] += leaf_cnt;
+
+  verify_proofs<H>(
+    q, leaves, leaf_idxs, proofs, roots, proof_cnt, depth, bitmap, wg_size);
+
+  for (size_t i = 0; i < proof_cnt; i++) {
+    const bool bad = i == bad_proof || i == bad_root || i == bad_leaf ||
+                     i == bad_idx || i == big_idx;
+    assert(passed(i) == (bad ? 0 : 1));
+  }
+
+  // bits beyond last proof are never set
+  assert((bitmap[proof_cnt >> 5] >> (proof_cnt & 31)) == 0);
+
+  // ensure resources are deallocated
+  sycl::free(in, q);
+  sycl::free(out, q);
+  sycl::free(leaves, q);
+  sycl::free(proofs, q);
+  sycl::free(roots, q);
+  sycl::free(leaf_idxs, q);
+  sycl::free(bitmap, q);
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "merklize_zero_copy.hpp"
+#include "test_utils.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+// Merklizes same random leaf nodes, living on device, shared, host & pageable
+// memory, using `merklize_zero_copy`, asserting that all intermediate nodes are
+// same as `merklize` computes, while leaf nodes are staged on accelerator
+// memory only when they can't be read in place
+template<typename H>
+void
+test_merklize_zero_copy(sycl::queue& q)
+{
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  // acquire resources
+  word_t* in[4];
+  in[0] = (word_t*)sycl::malloc_device(i_size, q);
+  in[1] = (word_t*)sycl::malloc_shared(i_size, q);
+  in[2] = (word_t*)sycl::malloc_host(i_size, q);
+  in[3] = (word_t*)std::malloc(i_size);
+  word_t* out_0 = (word_t*)sycl::malloc_shared(o_size, q);
+  word_t* out_1 = (word_t*)sycl::malloc_shared(o_size, q);
+
+  constexpr leaf_input srcs[] = { leaf_input::device,
+                                  leaf_input::shared,
+                                  leaf_input::host,
+                                  leaf_input::pageable };
+
+  fill_random(in[1], i_size);
+
+  q.memcpy(in[0], in[1], i_size).wait();
+  std::memcpy(in[2], in[1], i_size);
+  std::memcpy(in[3], in[1], i_size);
+
+  reference_merklize<H>(q, in[0], leaf_cnt, out_0);
+
+  for (size_t s = 0; s < 4; s++) {
+    assert(leaf_input_of(q, in[s]) == srcs[s]);
+
+    sycl::cl_ulong tx_ts[1];
+
+    q.memset(out_1, 0, o_size).wait();
+    merklize_zero_copy<H>(q,
+                          in[s],
+                          i_size,
+                          leaf_cnt,
+                          out_1,
+                          o_size,
+                          leaf_cnt - 1,
+                          wg_size,
+                          tx_ts);
+
+    // only staged leaf nodes are transferred
+    if (reads_in_place(q, srcs[s])) {
+      assert(tx_ts[0] == 0);
+    }
+
+    for (size_t i = 0; i < o_size / sizeof(word_t); i++) {
+      assert(out_0[i] == out_1[i]);
+    }
+  }
+
+  // ensure resources are deallocated
+  sycl::free(in[0], q);
+  sycl::free(in[1], q);
+  sycl::free(in[2], q);
+  std::free(in[3]);
+  sycl::free(out_0, q);
+  sycl::free(out_1, q);
+}
@@ -20,6 +20,7 @@ test_sha1(sycl::queue& q)
   sycl::uint* in_1 = static_cast<sycl::uint*>(sycl::malloc_shared(40, q));
   sycl::uchar* out_0 = static_cast<sycl::uchar*>(sycl::malloc_shared(20, q));
   sycl::uchar* out_1 = static_cast<sycl::uchar*>(sycl::malloc_shared(20, q));
+  sycl::uchar* out_2 = static_cast<sycl::uchar*>(sycl::malloc_shared(20, q));
 
 #pragma unroll 8
   for (size_t i = 0; i < 40; i++) {
@@ -57,10 +58,19 @@ test_sha1(sycl::queue& q)
   });
   q.wait();
 
+  q.single_task<class kernelTestSHA1_v2>([=]() {
+    sycl::uint digest[5];
+
+    sha1::hash_node(in_1, digest);
+    sha1::words_to_be_bytes(digest, out_2);
+  });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 20; i++) {
     assert(*(out_0 + i) == expected[i]);
     assert(*(out_1 + i) == expected[i]);
+    assert(*(out_2 + i) == expected[i]);
   }
 
   // ensure resources are deallocated
@@ -68,4 +78,5 @@ test_sha1(sycl::queue& q)
   sycl::free(in_1, q);
   sycl::free(out_0, q);
   sycl::free(out_1, q);
+  sycl::free(out_2, q);
 }
@@ -21,6 +21,8 @@ test_sha2_224(sycl::queue& q)
   sycl::uint* in_1 = static_cast<sycl::uint*>(sycl::malloc_shared(56, q));
   sycl::uchar* out_0 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
   sycl::uchar* out_1 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
+  sycl::uchar* out_2 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
+  sycl::uchar* out_3 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
 
 #pragma unroll 8
   for (size_t i = 0; i < 56; i++) {
@@ -81,10 +83,40 @@ test_sha2_224(sycl::queue& q)
   });
   q.wait();
 
+  q.single_task<class kernelTestSHA2_224_v2>([=]() {
+    sycl::uint digest[7];
+
+    sha2_224::hash_node(in_1, digest);
+
+    // converting each message word of digest into four consecutive big endian
+    // bytes
+#pragma unroll 7
+    for (size_t i = 0; i < 7; i++) {
+      from_words_to_be_bytes(*(digest + i), out_2 + i * 4);
+    }
+  });
+  q.wait();
+
+  q.single_task<class kernelTestSHA2_224_v3>([=]() {
+    sycl::uint digest[7];
+
+    sha2_224::hash_node_rolling(in_1, digest);
+
+    // converting each message word of digest into four consecutive big endian
+    // bytes
+#pragma unroll 7
+    for (size_t i = 0; i < 7; i++) {
+      from_words_to_be_bytes(*(digest + i), out_3 + i * 4);
+    }
+  });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 28; i++) {
     assert(*(out_0 + i) == expected[i]);
     assert(*(out_1 + i) == expected[i]);
+    assert(*(out_2 + i) == expected[i]);
+    assert(*(out_3 + i) == expected[i]);
   }
 
   // ensure resources are deallocated
@@ -92,4 +124,6 @@ test_sha2_224(sycl::queue& q)
   sycl::free(in_1, q);
   sycl::free(out_0, q);
   sycl::free(out_1, q);
+  sycl::free(out_2, q);
+  sycl::free(out_3, q);
 }
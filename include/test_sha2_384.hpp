@@ -23,6 +23,8 @@ test_sha2_384(sycl::queue& q)
   sycl::ulong* in_1 = static_cast<sycl::ulong*>(sycl::malloc_shared(96, q));
   sycl::uchar* out_0 = static_cast<sycl::uchar*>(sycl::malloc_shared(48, q));
   sycl::uchar* out_1 = static_cast<sycl::uchar*>(sycl::malloc_shared(48, q));
+  sycl::uchar* out_2 = static_cast<sycl::uchar*>(sycl::malloc_shared(48, q));
+  sycl::uchar* out_3 = static_cast<sycl::uchar*>(sycl::malloc_shared(48, q));
 
 #pragma unroll 16
   for (size_t i = 0; i < 96; i++) {
@@ -83,10 +85,40 @@ test_sha2_384(sycl::queue& q)
   });
   q.wait();
 
+  q.single_task<class kernelTestSHA2_384_v2>([=]() {
+    sycl::ulong digest[6];
+
+    sha2_384::hash_node(in_1, digest);
+
+    // converting each message word of digest into eight consecutive big endian
+    // bytes, making total 48 -bytes SHA2-384 digest
+#pragma unroll 6
+    for (size_t i = 0; i < 6; i++) {
+      from_words_to_be_bytes(*(digest + i), out_2 + (i << 3));
+    }
+  });
+  q.wait();
+
+  q.single_task<class kernelTestSHA2_384_v3>([=]() {
+    sycl::ulong digest[6];
+
+    sha2_384::hash_node_rolling(in_1, digest);
+
+    // converting each message word of digest into eight consecutive big endian
+    // bytes, making total 48 -bytes SHA2-384 digest
+#pragma unroll 6
+    for (size_t i = 0; i < 6; i++) {
+      from_words_to_be_bytes(*(digest + i), out_3 + (i << 3));
+    }
+  });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 48; i++) {
     assert(*(out_0 + i) == expected[i]);
     assert(*(out_1 + i) == expected[i]);
+    assert(*(out_2 + i) == expected[i]);
+    assert(*(out_3 + i) == expected[i]);
   }
 
   // ensure resources are deallocated
@@ -94,4 +126,6 @@ test_sha2_384(sycl::queue& q)
   sycl::free(in_1, q);
   sycl::free(out_0, q);
   sycl::free(out_1, q);
+  sycl::free(out_2, q);
+  sycl::free(out_3, q);
 }
@@ -24,6 +24,8 @@ test_sha2_512_224(sycl::queue& q)
   sycl::ulong* in_1 = static_cast<sycl::ulong*>(sycl::malloc_shared(56, q));
   sycl::uchar* out_0 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
   sycl::uchar* out_1 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
+  sycl::uchar* out_2 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
+  sycl::uchar* out_3 = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
 
 #pragma unroll 8
   for (size_t i = 0; i < 56; i++) {
@@ -94,10 +96,50 @@ test_sha2_512_224(sycl::queue& q)
   });
   q.wait();
 
+  q.single_task<class kernelTestSHA2_512_224_v2>([=]() {
+    sycl::ulong digest[4];
+
+    sha2_512_224::hash_node(in_1, digest);
+
+    // converting first three message word of digest into eight consecutive big
+    // endian bytes, making total first 24 -bytes SHA2-512/224 digest
+#pragma unroll 3
+    for (size_t i = 0; i < 3; i++) {
+      from_words_to_be_bytes(*(digest + i), out_2 + (i << 3));
+    }
+
+    // finally taking MSB 32 -bits of last message word of digest and converting
+    // to 4 consecutive big endian bytes
+    from_words_to_be_bytes(
+      static_cast<sycl::uint>((digest[3] >> 32) & 0xffffffff), out_2 + 24);
+  });
+  q.wait();
+
+  q.single_task<class kernelTestSHA2_512_224_v3>([=]() {
+    sycl::ulong digest[4];
+
+    sha2_512_224::hash_node_rolling(in_1, digest);
+
+    // converting first three message word of digest into eight consecutive big
+    // endian bytes, making total first 24 -bytes SHA2-512/224 digest
+#pragma unroll 3
+    for (size_t i = 0; i < 3; i++) {
+      from_words_to_be_bytes(*(digest + i), out_3 + (i << 3));
+    }
+
+    // finally taking MSB 32 -bits of last message word of digest and converting
+    // to 4 consecutive big endian bytes
+    from_words_to_be_bytes(
+      static_cast<sycl::uint>((digest[3] >> 32) & 0xffffffff), out_3 + 24);
+  });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 28; i++) {
     assert(*(out_0 + i) == expected[i]);
     assert(*(out_1 + i) == expected[i]);
+    assert(*(out_2 + i) == expected[i]);
+    assert(*(out_3 + i) == expected[i]);
   }
 
   // ensure resources are deallocated
@@ -105,4 +147,6 @@ test_sha2_512_224(sycl::queue& q)
   sycl::free(in_1, q);
   sycl::free(out_0, q);
   sycl::free(out_1, q);
+  sycl::free(out_2, q);
+  sycl::free(out_3, q);
 }
@@ -29,6 +29,10 @@ test_sha2_512_256(sycl::queue& q)
     sycl::malloc_shared(sha2_512_256::OUT_LEN_BYTES, q));
   sycl::uchar* out_1 = static_cast<sycl::uchar*>(
     sycl::malloc_shared(sha2_512_256::OUT_LEN_BYTES, q));
+  sycl::uchar* out_2 = static_cast<sycl::uchar*>(
+    sycl::malloc_shared(sha2_512_256::OUT_LEN_BYTES, q));
+  sycl::uchar* out_3 = static_cast<sycl::uchar*>(
+    sycl::malloc_shared(sha2_512_256::OUT_LEN_BYTES, q));
 
 #pragma unroll 32
   for (size_t i = 0; i < 64; i++) {
@@ -85,10 +89,36 @@ test_sha2_512_256(sycl::queue& q)
   });
   q.wait();
 
+  q.single_task<class kernelTestSHA2_512_256_v2>([=]() {
+    sycl::ulong digest[4];
+
+    sha2_512_256::hash_node(in_1, digest);
+
+#pragma unroll 4
+    for (size_t i = 0; i < 4; i++) {
+      from_words_to_be_bytes(digest[i], out_2 + (i << 3));
+    }
+  });
+  q.wait();
+
+  q.single_task<class kernelTestSHA2_512_256_v3>([=]() {
+    sycl::ulong digest[4];
+
+    sha2_512_256::hash_node_rolling(in_1, digest);
+
+#pragma unroll 4
+    for (size_t i = 0; i < 4; i++) {
+      from_words_to_be_bytes(digest[i], out_3 + (i << 3));
+    }
+  });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 32; i++) {
     assert(*(out_0 + i) == expected[i]);
     assert(*(out_1 + i) == expected[i]);
+    assert(*(out_2 + i) == expected[i]);
+    assert(*(out_3 + i) == expected[i]);
   }
 
   // ensure resources are deallocated
@@ -96,4 +126,6 @@ test_sha2_512_256(sycl::queue& q)
   sycl::free(in_1, q);
   sycl::free(out_0, q);
   sycl::free(out_1, q);
+  sycl::free(out_2, q);
+  sycl::free(out_3, q);
 }
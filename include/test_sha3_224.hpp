@@ -19,6 +19,8 @@ test_sha3_224(sycl::queue& q)
   // acquire resources
   sycl::uchar* in = static_cast<sycl::uchar*>(sycl::malloc_shared(56, q));
   sycl::uchar* out = static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
+  sycl::uchar* out_tree =
+    static_cast<sycl::uchar*>(sycl::malloc_shared(28, q));
 
 #pragma unroll 8
   for (size_t i = 0; i < 56; i++) {
@@ -30,12 +32,18 @@ test_sha3_224(sycl::queue& q)
   q.single_task<class kernelTestSHA3_224>([=]() { sha3_224::hash(in, out); });
   q.wait();
 
+  q.single_task<class kernelTestSHA3_224_v1>(
+    [=]() { sha3_224::hash_tree(in, out_tree); });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 28; i++) {
     assert(*(out + i) == expected[i]);
+    assert(out_tree[i] == expected[i]);
   }
 
   // ensure resources are deallocated
   sycl::free(in, q);
   sycl::free(out, q);
+  sycl::free(out_tree, q);
 }
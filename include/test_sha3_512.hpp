@@ -22,6 +22,12 @@ test_sha3_512(sycl::queue& q)
   // acquire resources
   sycl::uchar* in = static_cast<sycl::uchar*>(sycl::malloc_shared(128, q));
   sycl::uchar* out = static_cast<sycl::uchar*>(sycl::malloc_shared(64, q));
+  sycl::ulong* in_lanes =
+    static_cast<sycl::ulong*>(sycl::malloc_shared(128, q));
+  sycl::ulong* out_lanes =
+    static_cast<sycl::ulong*>(sycl::malloc_shared(64, q));
+  sycl::ulong* out_tree =
+    static_cast<sycl::ulong*>(sycl::malloc_shared(64, q));
 
 #pragma unroll 16
   for (size_t i = 0; i < 128; i++) {
@@ -29,16 +35,38 @@ test_sha3_512(sycl::queue& q)
     *(in + i) = i;
   }
 
+#pragma unroll 4
+  for (size_t i = 0; i < (128 >> 3); i++) {
+    sycl::ulong lane = 0ul;
+
+    // same input, as little-endian 64 -bit lanes
+    for (size_t j = 0; j < 8; j++) {
+      lane |= static_cast<sycl::ulong>((i << 3) + j) << (j << 3);
+    }
+    in_lanes[i] = lane;
+  }
+
   // enqueue kernel execution in single work-item model
   q.single_task<class kernelTestSHA3_512>([=]() { sha3_512::hash(in, out); });
   q.wait();
 
+  q.single_task<class kernelTestSHA3_512_v1>([=]() {
+    sha3_512::hash_lanes(in_lanes, out_lanes);
+    sha3_512::hash_tree(in_lanes, out_tree);
+  });
+  q.wait();
+
   // check result !
   for (size_t i = 0; i < 64; i++) {
     assert(*(out + i) == expected[i]);
+    assert(((out_lanes[i >> 3] >> ((i & 7) << 3)) & 0xff) == expected[i]);
+    assert(((out_tree[i >> 3] >> ((i & 7) << 3)) & 0xff) == expected[i]);
   }
 
   // ensure resources are deallocated
   sycl::free(in, q);
   sycl::free(out, q);
+  sycl::free(in_lanes, q);
+  sycl::free(out_lanes, q);
+  sycl::free(out_tree, q);
 }
@@ -0,0 +1,79 @@
+#pragma once
+#include "merklize.hpp"
+#include "usm_pool.hpp"
+#include <algorithm>
+#include <cassert>
+
+// Merklizes same leaf nodes few times, using buffers handed out by
+// `usm_pool`, asserting that buffers are recycled across calls ( as reported by
+// hit/ miss & bytes held statistics ), while roots stay same, as expected
+void
+test_usm_pool(sycl::queue& q)
+{
+  using H = hasher::sha2_256;
+  using word_t = typename H::word_t;
+
+  constexpr size_t leaf_cnt = 1 << 10;
+  constexpr size_t wg_size = 1 << 5;
+  constexpr size_t itr_cnt = 4;
+
+  constexpr size_t i_size = leaf_cnt * H::DIGEST_LEN_BYTES;
+  constexpr size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+
+  usm_pool pool{ q, true };
+
+  word_t root[H::NODE_WORDS];
+
+  for (size_t itr = 0; itr < itr_cnt; itr++) {
+    word_t* i_h = pool.allocate<word_t>(i_size, sycl::usm::alloc::host);
+    word_t* i_d = pool.allocate<word_t>(i_size, sycl::usm::alloc::device);
+    word_t* o_d = pool.allocate<word_t>(o_size, sycl::usm::alloc::device);
+    word_t* o_h = pool.allocate<word_t>(o_size, sycl::usm::alloc::host);
+
+    // buffers of same size & kind are never handed out twice at same time
+    assert(i_d != o_d);
+    assert(i_h != o_h);
+
+    for (size_t i = 0; i < i_size / sizeof(word_t); i++) {
+      i_h[i] = static_cast<word_t>(i * 0x9e3779b9u);
+    }
+
+    q.memcpy(i_d, i_h, i_size).wait();
+    merklize<H>(q, i_d, i_size, leaf_cnt, o_d, o_size, leaf_cnt - 1, wg_size);
+    q.memcpy(o_h, o_d, o_size).wait();
+
+    if (itr == 0) {
+      std::copy(o_h + H::NODE_WORDS, o_h + 2 * H::NODE_WORDS, root);
+    } else {
+      assert(node::equal<H>(o_h + H::NODE_WORDS, root));
+    }
+
+    pool.release(i_h);
+    pool.release(i_d);
+    pool.release(o_d);
+    pool.release(o_h);
+  }
+
+  // only first iteration allocates fresh USM, which is rounded up to its size
+  // class, while later iterations are served from free lists
+  usm_pool_stats st = pool.stats();
+  assert(st.misses == 4);
+  assert(st.hits == 4 * (itr_cnt - 1));
+  assert(st.bytes_in_use == 0);
+  assert(st.bytes_held >= 2 * (i_size + o_size));
+  assert(st.bytes_held <= 2 * (i_size + o_size) + (2 * (i_size + o_size) >> 2));
+
+  // sizes which aren't power of 2, land on quarter steps
+  {
+    void* ptr = pool.allocate(5 << 20, sycl::usm::alloc::shared);
+    st = pool.stats();
+    assert(st.bytes_in_use == 5 << 20);
+    pool.release(ptr);
+  }
+
+  pool.trim();
+
+  st = pool.stats();
+  assert(st.bytes_held == 0);
+  assert(st.bytes_in_use == 0);
+}
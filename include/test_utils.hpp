@@ -0,0 +1,40 @@
+#pragma once
+#include "merklize.hpp"
+#include <random>
+
+// Fills `size` -many bytes, starting at `ptr`, with uniformly random bytes
+inline void
+fill_random(void* const ptr, size_t size)
+{
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<sycl::uint> dis(0, 255);
+
+  sycl::uchar* const ptr_ = static_cast<sycl::uchar*>(ptr);
+  for (size_t i = 0; i < size; i++) {
+    ptr_[i] = static_cast<sycl::uchar>(dis(gen));
+  }
+}
+
+// Merklizes `leaf_cnt` -many ( power of 2 ) leaf nodes `in`, using `merklize`
+// with work-group size `wg_size` ( clamped to width of widest level ), writing
+// all intermediate nodes to `out` ( = leaf_cnt * NODE_LEN_BYTES -bytes ), which
+// is zeroed first, so that never touched first node is deterministic; other
+// merklization routines are tested against this
+template<typename H>
+void
+reference_merklize(sycl::queue& q,
+                   const typename H::word_t* const in,
+                   size_t leaf_cnt,
+                   typename H::word_t* const out,
+                   size_t wg_size = 1 << 5)
+{
+  using word_t = typename H::word_t;
+
+  const size_t i_size = (leaf_cnt >> 1) * H::LEAF_PAIR_WORDS * sizeof(word_t);
+  const size_t o_size = leaf_cnt * H::NODE_LEN_BYTES;
+  const size_t wg_size_ = std::min(wg_size, leaf_cnt >> 1);
+
+  q.memset(out, 0, o_size).wait();
+  merklize<H>(q, in, i_size, leaf_cnt, out, o_size, leaf_cnt - 1, wg_size_);
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include <CL/sycl.hpp>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Counters kept by `usm_pool`, where a hit is an allocation request served
+// using a previously released buffer, while a miss had to allocate fresh USM
+struct usm_pool_stats
+{
+  size_t hits;
+  size_t misses;
+  size_t bytes_held;   // total size of all buffers owned by pool
+  size_t bytes_in_use; // total size of buffers currently handed out
+};
+
+// Size-class arena of host, device & shared USM allocations, which is meant
+// to be owned by a long-lived object ( say a service, serving merklization
+// requests ), so that leaf, intermediate & scratch buffers of repeated
+// merklization calls are recycled, instead of paying for USM allocation &
+// first-touch page faults, on each call
+//
+// Requested size is rounded up to its size class, where each power of 2
+// interval ( >= 4 KB ) is split into 4 equal steps, so that at max 1/4 of
+// buffer is wasted, while released buffers are kept on one free list per kind
+// of USM & size class, until pool is trimmed or destroyed
+//
+// When `prefault` is set, freshly allocated buffers are touched once ( device
+// & shared USM on device, host USM on host ), so that page faults are paid
+// at allocation time, rather than during first kernel dispatch/ data transfer
+//
+// Allocation & release requests are serialized using a mutex, so that pool can
+// be shared by concurrent callers
+//
+// Pool keeps a reference to `q`, which all buffers are allocated & freed using,
+// so queue must outlive pool, while all buffers handed out by pool must be
+// released before pool is destroyed, as it never frees buffers which are still
+// in use
+class usm_pool
+{
+public:
+  usm_pool(sycl::queue& q, bool prefault)
+    : q(q)
+    , prefault(prefault)
+    , hits(0)
+    , misses(0)
+    , bytes_held(0)
+    , bytes_in_use(0)
+  {}
+
+  usm_pool(const usm_pool&) = delete;
+  usm_pool& operator=(const usm_pool&) = delete;
+
+  ~usm_pool()
+  {
+    // buffers still handed out would otherwise be left dangling
+    assert(live.empty());
+    trim();
+  }
+
+  // Hands out USM buffer of `kind` ( host, device or shared ), which is at
+  // least `size` -bytes, to be given back using `release`
+  template<typename T>
+  T* allocate(size_t size, sycl::usm::alloc kind)
+  {
+    return static_cast<T*>(allocate(size, kind));
+  }
+
+  void* allocate(size_t size, sycl::usm::alloc kind)
+  {
+    const size_t cls_size = size_class(size);
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    std::vector<void*>& list = free_lists[kind_index(kind)][cls_size];
+
+    void* ptr = nullptr;
+    if (!list.empty()) {
+      ptr = list.back();
+      list.pop_back();
+      hits++;
+    } else {
+      ptr = sycl::malloc(cls_size, q, kind);
+      assert(ptr != nullptr);
+
+      misses++;
+      bytes_held += cls_size;
+
+      if (prefault) {
+        touch(ptr, cls_size, kind);
+      }
+    }
+
+    live.emplace(ptr, buffer{ kind, cls_size });
+    bytes_in_use += cls_size;
+
+    return ptr;
+  }
+
+  // Gives back buffer handed out by `allocate`, so that it can be recycled
+  void release(void* const ptr)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = live.find(ptr);
+    assert(it != live.end());
+
+    const buffer buf = it->second;
+    live.erase(it);
+
+    free_lists[kind_index(buf.kind)][buf.size].push_back(ptr);
+    bytes_in_use -= buf.size;
+  }
+
+  // Frees all released buffers, which are kept around for recycling, while
+  // buffers which are still handed out are not touched
+  void trim()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (auto& lists : free_lists) {
+      for (auto& [size, list] : lists) {
+        for (void* ptr : list) {
+          sycl::free(ptr, q);
+        }
+      }
+      lists.clear();
+    }
+
+    bytes_held = bytes_in_use;
+  }
+
+  usm_pool_stats stats() const
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    return usm_pool_stats{ hits, misses, bytes_held, bytes_in_use };
+  }
+
+private:
+  struct buffer
+  {
+    sycl::usm::alloc kind;
+    size_t size; // size class
+  };
+
+  // smallest size class is 4 KB i.e. a page
+  static constexpr size_t MIN_SIZE = 1ul << 12;
+  // host, device & shared USM
+  static constexpr size_t KIND_CNT = 3;
+
+  // Rounds `size` up to multiple of 2 ^ (e - 2), where 2 ^ e < size <= 2 ^ (e
+  // + 1)
+  static size_t size_class(size_t size)
+  {
+    if (size <= MIN_SIZE) {
+      return MIN_SIZE;
+    }
+
+    size_t e = 0;
+    while ((2ul << e) < size) {
+      e++;
+    }
+
+    const size_t step = 1ul << (e - 2);
+    return (size + step - 1) & ~(step - 1);
+  }
+
+  static size_t kind_index(sycl::usm::alloc kind)
+  {
+    switch (kind) {
+      case sycl::usm::alloc::host:
+        return 0;
+      case sycl::usm::alloc::device:
+        return 1;
+      default:
+        return 2;
+    }
+  }
+
+  void touch(void* const ptr, size_t size, sycl::usm::alloc kind)
+  {
+    if (kind == sycl::usm::alloc::host) {
+      std::memset(ptr, 0, size);
+    } else {
+      q.memset(ptr, 0, size).wait();
+    }
+  }
+
+  sycl::queue& q;
+  const bool prefault;
+
+  mutable std::mutex mtx;
+  std::unordered_map<size_t, std::vector<void*>> free_lists[KIND_CNT];
+  std::unordered_map<void*, buffer> live;
+
+  size_t hits;
+  size_t misses;
+  size_t bytes_held;
+  size_t bytes_in_use;
+};
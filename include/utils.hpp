@@ -7,7 +7,7 @@
 //
 // See section 3.2's point 4 in Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::uint
+constexpr sycl::uint
 rotr(sycl::uint x, size_t n)
 {
   return (x >> n) | (x << (32 - n));
@@ -22,7 +22,7 @@ rotr(sycl::uint x, size_t n)
 //
 // See section 3.2's point 4 in Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 rotr(sycl::ulong x, size_t n)
 {
   return (x >> n) | (x << (64 - n));
@@ -34,7 +34,7 @@ rotr(sycl::ulong x, size_t n)
 //
 // See section 3.2's point 5 in Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::uint
+constexpr sycl::uint
 rotl(sycl::uint x, size_t n)
 {
   return (x << n) | (x >> (32 - n));
@@ -49,12 +49,46 @@ rotl(sycl::uint x, size_t n)
 //
 // See section 3.2's point 4 in Secure Hash Standard
 // http://dx.doi.org/10.6028/NIST.FIPS.180-4
-inline sycl::ulong
+constexpr sycl::ulong
 rotl(sycl::ulong x, size_t n)
 {
   return (x << n) | (x >> (64 - n));
 }
 
+// # -of message blocks ( each of sixteen 32 -bit or 64 -bit words ), which are
+// consumed by 2-to-1 hash function of SHA1/ SHA2 family, when hashing
+// `msg_words` -many message words ( two concatenated digests ), after padding
+// it; padding needs at least one word for appending 1 -bit & two words for
+// keeping length of message
+//
+// See section 5.1 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+constexpr size_t
+node_block_cnt(size_t msg_words)
+{
+  return msg_words + 3 <= 16 ? 1 : 2;
+}
+
+// Word at index `idx` of padded message, when hashing `msg_words` -many message
+// words using 2-to-1 hash function of SHA1/ SHA2 family; as length of message
+// is known at compile-time, so are all padding words, while 0 is returned for
+// indices < `msg_words`, which belong to message itself
+//
+// See section 5.1 of Secure Hash Standard
+// http://dx.doi.org/10.6028/NIST.FIPS.180-4
+template<typename W>
+constexpr W
+node_padding_word(size_t msg_words, size_t idx)
+{
+  if (idx == msg_words) {
+    return W{ 1 } << (sizeof(W) * 8 - 1);
+  }
+  if (idx == node_block_cnt(msg_words) * 16 - 1) {
+    return static_cast<W>(msg_words * sizeof(W) * 8);
+  }
+  return W{ 0 };
+}
+
 // Profile execution time of some command, whose submission resulted into
 // provided SYCL event
 //
@@ -173,3 +207,124 @@ from_bit_interleaved(const uint32_t interleaved_even,
 
   return word;
 }
+
+// Gathers bits living on even bit indices of 64 -bit word into lower 32 bits
+// of result, preserving their order, using log2(64) shift & mask steps, instead
+// of testing each bit
+constexpr uint64_t
+gather_even_bits(uint64_t x)
+{
+  x &= 0x5555555555555555ull;
+  x = (x | (x >> 1)) & 0x3333333333333333ull;
+  x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0full;
+  x = (x | (x >> 4)) & 0x00ff00ff00ff00ffull;
+  x = (x | (x >> 8)) & 0x0000ffff0000ffffull;
+  x = (x | (x >> 16)) & 0x00000000ffffffffull;
+
+  return x;
+}
+
+// Spreads lower 32 bits of word onto even bit indices of 64 -bit result, which
+// is inverse of `gather_even_bits`
+constexpr uint64_t
+spread_to_even_bits(uint64_t x)
+{
+  x &= 0x00000000ffffffffull;
+  x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+  x = (x | (x << 2)) & 0x3333333333333333ull;
+  x = (x | (x << 1)) & 0x5555555555555555ull;
+
+  return x;
+}
+
+// Same as `to_bit_interleaved`, but computed in constant time, using shift &
+// mask steps, without branching on each bit of 64 -bit word
+//
+// See section 2.1 of https://keccak.team/files/Keccak-implementation-3.2.pdf
+constexpr void
+to_bit_interleaved_fast(const uint64_t word,
+                        uint32_t* interleaved_even,
+                        uint32_t* interleaved_odd)
+{
+  *interleaved_even = static_cast<uint32_t>(gather_even_bits(word));
+  *interleaved_odd = static_cast<uint32_t>(gather_even_bits(word >> 1));
+}
+
+// Same as `from_bit_interleaved`, but computed in constant time, using shift &
+// mask steps, without branching on each bit of 64 -bit word
+//
+// See section 2.1 of https://keccak.team/files/Keccak-implementation-3.2.pdf
+constexpr uint64_t
+from_bit_interleaved_fast(const uint32_t interleaved_even,
+                          const uint32_t interleaved_odd)
+{
+  return spread_to_even_bits(interleaved_even) |
+         (spread_to_even_bits(interleaved_odd) << 1);
+}
+
+// Pads `len` -bytes message, as specified in section 5.1 of Secure Hash
+// Standard http://dx.doi.org/10.6028/NIST.FIPS.180-4, and parses it into
+// BLOCK_LEN -bytes message blocks, where each consecutive big endian bytes are
+// interpreted as word of type `W` ( 32 -bit/ 64 -bit ); each message block is
+// passed to `f`, in order, as (BLOCK_LEN / sizeof(W)) -many words
+//
+// Message length ( in bits ) is appended as LEN_BYTES -bytes big endian
+// integer, where LEN_BYTES is 8 for SHA1/ SHA2-{224, 256} and 16 for
+// SHA2-{384, 512, 512/224, 512/256}
+template<typename W, size_t BLOCK_LEN, size_t LEN_BYTES, typename F>
+inline void
+for_each_padded_block(const sycl::uchar* __restrict msg, size_t len, F&& f)
+{
+  constexpr size_t WORD_CNT = BLOCK_LEN / sizeof(W);
+
+  auto parse = [](const sycl::uchar* in, W* const out) {
+#pragma unroll 16
+    for (size_t i = 0; i < WORD_CNT; i++) {
+      if constexpr (sizeof(W) == 4) {
+        out[i] = from_be_bytes_to_u32_words(in + i * sizeof(W));
+      } else {
+        out[i] = from_be_bytes_to_u64_words(in + i * sizeof(W));
+      }
+    }
+  };
+
+  W words[WORD_CNT];
+
+  // all complete message blocks, which don't need any padding
+  const size_t blk_cnt = len / BLOCK_LEN;
+  for (size_t b = 0; b < blk_cnt; b++) {
+    parse(msg + b * BLOCK_LEN, words);
+    f(words);
+  }
+
+  // remaining bytes, followed by 1 -bit, 0 -bits and message length, occupy
+  // one or two message blocks
+  const size_t rem = len - blk_cnt * BLOCK_LEN;
+  const size_t tail_len =
+    rem + 1 + LEN_BYTES <= BLOCK_LEN ? BLOCK_LEN : BLOCK_LEN << 1;
+
+  sycl::uchar tail[BLOCK_LEN << 1];
+
+  for (size_t i = 0; i < rem; i++) {
+    tail[i] = msg[blk_cnt * BLOCK_LEN + i];
+  }
+  tail[rem] = 0b10000000;
+  for (size_t i = rem + 1; i < tail_len; i++) {
+    tail[i] = 0;
+  }
+
+  // message can't be longer than 2 ^ 64 -bytes, so only lowest 67 -bits of
+  // length ( in bits ) can be non-zero
+  const sycl::ulong bit_len = static_cast<sycl::ulong>(len) << 3;
+  from_words_to_be_bytes(bit_len, tail + tail_len - 8);
+  if constexpr (LEN_BYTES > 8) {
+    tail[tail_len - 9] = static_cast<sycl::uchar>(len >> 61);
+  }
+
+  for (size_t b = 0; b < tail_len; b += BLOCK_LEN) {
+    parse(tail + b, words);
+    f(words);
+  }
+}
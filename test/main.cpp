@@ -1,32 +1,38 @@
 #include "test_bit_interleaving.hpp"
+#include "test_keccak_256.hpp"
 #include "test_merklize.hpp"
-#include <iostream>
-
-#if defined SHA1
+#include "test_merklize_arbitrary.hpp"
+#include "test_merklize_autotune.hpp"
+#include "test_merklize_batch.hpp"
+#include "test_merklize_file.hpp"
+#include "test_merklize_fused.hpp"
+#include "test_merklize_hybrid.hpp"
+#include "test_merklize_incremental.hpp"
+#include "test_merklize_interleaved.hpp"
+#include "test_merklize_leaves.hpp"
+#include "test_merklize_materialize.hpp"
+#include "test_merklize_numa.hpp"
+#include "test_merklize_persistent.hpp"
+#include "test_merklize_pipelined.hpp"
+#include "test_merklize_proof.hpp"
+#include "test_merklize_readback.hpp"
+#include "test_merklize_resident.hpp"
+#include "test_merklize_stream.hpp"
+#include "test_merklize_verify.hpp"
+#include "test_merklize_zero_copy.hpp"
 #include "test_sha1.hpp"
-#elif defined SHA2_224
 #include "test_sha2_224.hpp"
-#elif defined SHA2_256
 #include "test_sha2_256.hpp"
-#elif defined SHA2_384
 #include "test_sha2_384.hpp"
-#elif defined SHA2_512
 #include "test_sha2_512.hpp"
-#elif defined SHA2_512_224
 #include "test_sha2_512_224.hpp"
-#elif defined SHA2_512_256
 #include "test_sha2_512_256.hpp"
-#elif defined SHA3_256
-#include "test_sha3_256.hpp"
-#elif defined SHA3_224
 #include "test_sha3_224.hpp"
-#elif defined SHA3_384
+#include "test_sha3_256.hpp"
 #include "test_sha3_384.hpp"
-#elif defined SHA3_512
 #include "test_sha3_512.hpp"
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-#include "test_keccak_256.hpp"
-#endif
+#include "test_usm_pool.hpp"
+#include <iostream>
 
 int
 main(int argc, char** argv)
@@ -44,111 +50,133 @@ main(int argc, char** argv)
   test_bit_interleaving<1ul << 20>();
   std::cout << "passed bit interleaving test !" << std::endl;
 
-#if defined SHA1
-
   test_sha1(q);
   std::cout << "passed SHA1     test !" << std::endl;
 
-#elif defined SHA2_224
-
   test_sha2_224(q);
   std::cout << "passed SHA2-224 test !" << std::endl;
 
-#elif defined SHA2_256
-
   test_sha2_256(q);
   std::cout << "passed SHA2-256 test !" << std::endl;
 
-#elif defined SHA2_384
-
   test_sha2_384(q);
   std::cout << "passed SHA2-384 test !" << std::endl;
 
-#elif defined SHA2_512
-
   test_sha2_512(q);
   std::cout << "passed SHA2-512 test !" << std::endl;
 
-#elif defined SHA2_512_224
-
   test_sha2_512_224(q);
   std::cout << "passed SHA2-512/224 test !" << std::endl;
 
-#elif defined SHA2_512_256
-
   test_sha2_512_256(q);
   std::cout << "passed SHA2-512/256 test !" << std::endl;
 
-#elif defined SHA3_256
-
   test_sha3_256(q);
   std::cout << "passed SHA3-256 test !" << std::endl;
 
-#elif defined SHA3_224
-
   test_sha3_224(q);
   std::cout << "passed SHA3-224 test !" << std::endl;
 
-#elif defined SHA3_384
-
   test_sha3_384(q);
   std::cout << "passed SHA3-384 test !" << std::endl;
 
-#elif defined SHA3_512
-
   test_sha3_512(q);
   std::cout << "passed SHA3-512 test !" << std::endl;
 
-#elif defined KECCAK_256_U64 || defined KECCAK_256_U32
-
   test_keccak_256(q);
   std::cout << "passed Keccak-256 test !" << std::endl;
 
-#endif
+  test_usm_pool(q);
+  std::cout << "passed USM buffer pool test !" << std::endl;
 
-  test_merklize(q);
+  test_merklize_interleaved(q);
+  std::cout << "passed bit interleaved Keccak-256 tree test !" << std::endl;
 
-#if defined SHA1
-  std::cout << "passed binary merklization ( using SHA1 ) test !" << std::endl;
-#elif defined SHA2_224
-  std::cout << "passed binary merklization ( using SHA2-224 ) test !"
-            << std::endl;
-#elif defined SHA2_256
-  std::cout << "passed binary merklization ( using SHA2-256 ) test !"
-            << std::endl;
-#elif defined SHA2_384
-  std::cout << "passed binary merklization ( using SHA2-384 ) test !"
-            << std::endl;
-#elif defined SHA2_512
-  std::cout << "passed binary merklization ( using SHA2-512 ) test !"
-            << std::endl;
-#elif defined SHA2_512_224
-  std::cout << "passed binary merklization ( using SHA2-512/224 ) test !"
-            << std::endl;
-#elif defined SHA2_512_256
-  std::cout << "passed binary merklization ( using SHA2-512/256 ) test !"
+  test_merklize_autotune_wg_limit(q);
+  std::cout << "passed work-group size limited SHA2-512 autotuning test !"
             << std::endl;
-#elif defined SHA3_256
-  std::cout << "passed binary merklization ( using SHA3-256 ) test !"
-            << std::endl;
-#elif defined SHA3_224
-  std::cout << "passed binary merklization ( using SHA3-224 ) test !"
-            << std::endl;
-#elif defined SHA3_384
-  std::cout << "passed binary merklization ( using SHA3-384 ) test !"
-            << std::endl;
-#elif defined SHA3_512
-  std::cout << "passed binary merklization ( using SHA3-512 ) test !"
-            << std::endl;
-#elif defined KECCAK_256_U64
-  std::cout
-    << "passed binary merklization ( using KECCAK-256, 64 -bit word ) test !"
-    << std::endl;
-#elif defined KECCAK_256_U32
-  std::cout
-    << "passed binary merklization ( using KECCAK-256, 32 -bit word ) test !"
-    << std::endl;
-#endif
+
+  // prints which SHA variant passed
+  test_merklize(q);
+
+  // all merklization routines are tested with each SHA variant
+  for (hasher::variant v : hasher::VARIANTS) {
+    hasher::dispatch(v, [&](auto h) {
+      using H = decltype(h);
+
+      test_merklize_fused<H>(q);
+      std::cout << "passed fused binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_persistent<H>(q);
+      std::cout << "passed persistent binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_hybrid<H>(q);
+      std::cout << "passed hybrid binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_arbitrary<H>(q);
+      std::cout << "passed arbitrary leaf count binary merklization ( using "
+                << H::NAME << " ) test !" << std::endl;
+
+      test_merklize_batch<H>(q);
+      std::cout << "passed batched binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_incremental<H>(q);
+      std::cout << "passed incremental binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_resident<H>(q);
+      std::cout << "passed resident binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_proof<H>(q);
+      std::cout << "passed merkle proof extraction ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_verify<H>(q);
+      std::cout << "passed batched merkle proof verification ( using "
+                << H::NAME << " ) test !" << std::endl;
+
+      test_merklize_stream<H>(q);
+      std::cout << "passed out-of-core binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_pipelined<H>(q);
+      std::cout << "passed pipelined binary merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_readback<H>(q);
+      std::cout << "passed level by level readback merklization ( using "
+                << H::NAME << " ) test !" << std::endl;
+
+      test_merklize_materialize<H>(q);
+      std::cout << "passed partially materialized merklization ( using "
+                << H::NAME << " ) test !" << std::endl;
+
+      test_merklize_leaves<H>(q);
+      std::cout << "passed raw leaf data hashing ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_zero_copy<H>(q);
+      std::cout << "passed zero-copy leaf input merklization ( using "
+                << H::NAME << " ) test !" << std::endl;
+
+      test_merklize_file<H>(q);
+      std::cout << "passed memory mapped leaf file merklization ( using "
+                << H::NAME << " ) test !" << std::endl;
+
+      test_merklize_autotune<H>(q);
+      std::cout << "passed autotuned merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+
+      test_merklize_numa<H>(q);
+      std::cout << "passed NUMA partitioned merklization ( using " << H::NAME
+                << " ) test !" << std::endl;
+    });
+  }
 
   return EXIT_SUCCESS;
 }